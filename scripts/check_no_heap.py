@@ -0,0 +1,88 @@
+# 构建后检查：动作 / 调度这几块的目标文件里不许引用堆分配
+# 用 nm 列出每个 .o 的未定义符号，碰到 malloc / new / String 之类就让构建失败，
+# 报出是哪个文件引用了哪个符号（c++filt 还原名字）。
+#
+# PlatformIO：platformio.ini 里 extra_scripts = post:scripts/check_no_heap.py，链接完自动跑
+# 单独用：python3 scripts/check_no_heap.py [--nm <nm>] a.o b.o ...
+import os
+import re
+import subprocess
+import sys
+
+# 相对 src/ 的源文件：舵机播放器、灯效跟动作、sys 任务调度、事件总线、双核、实时流
+HEAP_FREE_SOURCES = (
+    "servo/servo_in.cpp",
+    "ws2812/ws2812_motion.cpp",
+    "sys/sys.cpp",
+    "sys/bus.cpp",
+    "sys/cores.cpp",
+    "stream/stream_in.cpp",
+)
+
+# 未定义符号（编译器看到的名字，没还原）
+HEAP_SYMBOLS = re.compile(
+    r"^(malloc|calloc|realloc|free|strdup|strndup|"
+    r"pvPortMalloc|vPortFree|heap_caps_\w+|"
+    r"__cxa_allocate_exception|"
+    r"_Zn[wa]\w*|_Zd[la]\w*|"          # operator new / new[] / delete / delete[]
+    r"\w*6String\w*|"                    # Arduino String
+    r"\w*basic_string\w*)$"             # std::string
+)
+
+
+def undefined_symbols(nm, obj):
+    out = subprocess.run([nm, "-u", obj], check=True, capture_output=True, text=True).stdout
+    return [line.split()[-1] for line in out.splitlines() if line.strip()]
+
+
+def demangle(sym):
+    try:
+        return subprocess.run(["c++filt", sym], check=True, capture_output=True, text=True).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return sym
+
+
+def check(nm, objs):
+    bad = 0
+    for obj in objs:
+        if not os.path.isfile(obj):
+            print("check_no_heap: missing %s" % obj)
+            bad += 1
+            continue
+        for sym in undefined_symbols(nm, obj):
+            if HEAP_SYMBOLS.match(sym):
+                print("check_no_heap: %s uses %s" % (obj, demangle(sym)))
+                bad += 1
+    return bad
+
+
+def _pio_main(env):
+    build_dir = env.subst("$BUILD_DIR")
+    cc = env.subst("$CC")
+    nm = cc[:-3] + "nm" if cc.endswith("gcc") else "nm"
+
+    def after_link(target, source, env):
+        objs = [os.path.join(build_dir, "src", s + ".o") for s in HEAP_FREE_SOURCES]
+        objs = [o for o in objs if os.path.isfile(o)]   # 不在这个环境 build_src_filter 里的跳过
+        bad = check(nm, objs)
+        if bad:
+            sys.stderr.write("check_no_heap: %d heap reference(s) in hot-path code\n" % bad)
+            env.Exit(1)
+        print("check_no_heap: %d object(s) clean" % len(objs))
+
+    env.AddPostAction("$PROGPATH", after_link)
+
+
+if __name__ == "__main__":
+    args = sys.argv[1:]
+    nm = "nm"
+    if len(args) >= 2 and args[0] == "--nm":
+        nm, args = args[1], args[2:]
+    if not args:
+        sys.exit("usage: check_no_heap.py [--nm <nm>] <obj>...")
+    n = check(nm, args)
+    print("check_no_heap: %d object(s), %d heap reference(s)" % (len(args), n))
+    sys.exit(1 if n else 0)
+else:
+    Import("env")  # noqa: F821  (PlatformIO / SCons 注入)
+    _pio_main(env)  # noqa: F821
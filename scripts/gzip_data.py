@@ -0,0 +1,35 @@
+# 构建文件系统镜像前把 data/ 里的静态资源 gzip 一遍
+# 输出到 .pio/build/<env>/data_gz/<name>.gz，并把它设为 buildfs / uploadfs 的数据目录
+# 原文件也一起拷过去：固件端 web_assets.cpp 对收 gzip 的客户端发 .gz（Content-Encoding: gzip），
+# 不收 gzip 的客户端发原文件
+Import("env")
+
+import gzip
+import os
+import shutil
+
+src_dir = env.subst("$PROJECT_DATA_DIR")
+out_dir = os.path.join(env.subst("$BUILD_DIR"), "data_gz")
+
+# 只压网页文本资源；动作文件等固件自己读的文件原样拷贝
+GZIP_EXT = (".html", ".js", ".css", ".json", ".svg", ".ico", ".txt")
+
+if os.path.isdir(src_dir):
+    shutil.rmtree(out_dir, ignore_errors=True)
+    for root, _, files in os.walk(src_dir):
+        rel = os.path.relpath(root, src_dir)
+        dst_root = os.path.normpath(os.path.join(out_dir, rel))
+        os.makedirs(dst_root, exist_ok=True)
+        for name in files:
+            src = os.path.join(root, name)
+            shutil.copy2(src, os.path.join(dst_root, name))
+            if not name.lower().endswith(GZIP_EXT):
+                continue
+            with open(src, "rb") as f:
+                data = f.read()
+            # mtime=0：内容不变则 .gz 字节不变，ETag 也不变
+            with open(os.path.join(dst_root, name + ".gz"), "wb") as f:
+                f.write(gzip.compress(data, compresslevel=9, mtime=0))
+
+    env.Replace(PROJECT_DATA_DIR=out_dir)
+    print("gzip_data: %s -> %s" % (src_dir, out_dir))
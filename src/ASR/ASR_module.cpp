@@ -1,12 +1,16 @@
 #include "ASR_module.h"
 
+static AsrI2cStats g_i2c_stats = {};
 
+const AsrI2cStats &asr_i2c_stats()
+{
+    return g_i2c_stats;
+}
 
 static bool WireWriteByte(uint8_t val)
 {
-    Wire.beginTransmission(I2C_ADDR);
-    Wire.write(val);
-    if( Wire.endTransmission() != 0 ) {
+    if( !hal_i2c_write(I2C_ADDR, &val, 1) ) {
+        g_i2c_stats.write_errors++;
         return false;
     }
     return true;
@@ -14,14 +18,12 @@ static bool WireWriteByte(uint8_t val)
 
 static bool WireWriteDataArray(  uint8_t reg,uint8_t *val,unsigned int len)
 {
-    unsigned int i;
-
-    Wire.beginTransmission(I2C_ADDR);
-    Wire.write(reg);
-    for(i = 0; i < len; i++) {
-        Wire.write(val[i]);
-    }
-    if( Wire.endTransmission() != 0 ) {
+    uint8_t buf[8];
+    if (len + 1 > sizeof(buf)) return false;
+    buf[0] = reg;
+    memcpy(&buf[1], val, len);
+    if( !hal_i2c_write(I2C_ADDR, buf, len + 1) ) {
+        g_i2c_stats.write_errors++;
         return false;
     }
     return true;
@@ -29,21 +31,14 @@ static bool WireWriteDataArray(  uint8_t reg,uint8_t *val,unsigned int len)
 
 static int WireReadDataArray(   uint8_t reg, uint8_t *val, unsigned int len)
 {
-    unsigned char i = 0;  
     /* Indicate which register we want to read from */
     if (!WireWriteByte(reg)) {
         return -1;
     }
-    Wire.requestFrom(I2C_ADDR, len);
-    while (Wire.available()) {
-        if (i >= len) {
-            return -1;
-        }
-        val[i] = Wire.read();
-        i++;
-    }
-    /* Read block data */    
-    return i;
+    /* Read block data */
+    size_t got = hal_i2c_read(I2C_ADDR, val, len);
+    if (got != len) g_i2c_stats.read_errors++;
+    return (int)got;
 }
 
 ASR_MOUDLE::ASR_MOUDLE(void)
@@ -55,6 +50,7 @@ ASR_MOUDLE::ASR_MOUDLE(void)
 uint8_t ASR_MOUDLE::rec_recognition(void)
 {
   uint8_t result = 0;
+  g_i2c_stats.polls++;
   WireReadDataArray(ASR_RESULT_ADDR,&result,1);
   return result;
 }
@@ -70,5 +66,5 @@ void ASR_MOUDLE::speak(uint8_t cmd , uint8_t id)
 }
 
 void ASR_MOUDLE::ASR_init(){
-    Wire.begin(SDA_PIN, SCL_PIN); 
+    hal_i2c_begin(SDA_PIN, SCL_PIN);
 }
@@ -1,7 +1,7 @@
 #ifndef __ASR_MODULE_H
 #define __ASR_MODULE_H
 
-#include <Wire.h>
+#include "../hal/hal.h"
 
 #define I2C_ADDR		0x34
 //识别结果存放处，通过不断读取此地址的值判断是否识别到语音，不同的值对应不同的语音
@@ -14,6 +14,15 @@
 #define SDA_PIN 48  // 定义 SDA 引脚
 #define SCL_PIN 47  // 定义 SCL 引脚
 
+// I2C 通信统计（只增不减）
+struct AsrI2cStats {
+  uint32_t polls;          // rec_recognition 调用次数
+  uint32_t write_errors;   // hal_i2c_write 失败（NACK / 超时 / 总线错误）
+  uint32_t read_errors;    // 读回字节数不对
+};
+
+const AsrI2cStats &asr_i2c_stats();
+
 class ASR_MOUDLE
 {
   public:
@@ -1,14 +1,14 @@
 #include "config.h"
 
 void config_init(){
-    pinMode(Leaser_pin_1,OUTPUT);
-    pinMode(Leaser_pin_2,OUTPUT);
-    pinMode(Leaser_pin_3,OUTPUT);
-    pinMode(Radar_pin,OUTPUT);
-    digitalWrite(Leaser_pin_1, LOW);
-    digitalWrite(Leaser_pin_2, LOW);
-    digitalWrite(Leaser_pin_3, LOW);
-    digitalWrite(Radar_pin, HIGH);
+    hal_gpio_output(Leaser_pin_1);
+    hal_gpio_output(Leaser_pin_2);
+    hal_gpio_output(Leaser_pin_3);
+    hal_gpio_output(Radar_pin);
+    hal_gpio_write(Leaser_pin_1, HAL_LOW);
+    hal_gpio_write(Leaser_pin_2, HAL_LOW);
+    hal_gpio_write(Leaser_pin_3, HAL_LOW);
+    hal_gpio_write(Radar_pin, HAL_HIGH);
 }
 
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Arduino.h>
+#include "../hal/hal.h"
 
 #define Leaser_pin_1 10
 #define Leaser_pin_2 13
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/* =========================
+ * 硬件抽象层
+ *
+ * 舵机 / 灯带 / 任务 / 串口命令这几块只通过这里碰硬件，换一份实现就能在主机上跑：
+ *   hal_esp32.cpp    ESP32 + Arduino（默认）
+ *   hal_native.cpp   Linux，编译时定义 HAL_NATIVE（platformio.ini 的 [env:native]）
+ * 灯带输出的抽象就是 ws2812_out.h，主机实现在 ws2812_out_native.cpp。
+ * 主机独有的接口（虚拟时钟、串口注入、输出回调）在 hal_native.h。
+ * WiFi / Web / HTTP 上传 / 指标只在 ESP32 上编译，不走这里。
+ *
+ * 接口都是非阻塞的（hal_delay_ms 除外，只给开机流程用；I2C 是几个字节的短传输，只在 IO 侧调），
+ * 不做动态分配。
+ * ========================= */
+
+#define HAL_LOW   0
+#define HAL_HIGH  1
+
+// ---------- 时钟 ----------
+uint32_t hal_millis();
+uint32_t hal_micros();
+void     hal_delay_ms(uint32_t ms);
+
+// ---------- GPIO ----------
+void hal_gpio_output(uint8_t pin);
+void hal_gpio_write(uint8_t pin, uint8_t level);
+int  hal_gpio_read(uint8_t pin);      // 输出脚读回当前电平
+
+// ---------- 舵机（50Hz PWM） ----------
+#define HAL_SERVO_MAX  8
+
+int8_t hal_servo_attach(int8_t pin);            // 返回通道号，<0 = 没有空通道
+void   hal_servo_write(int8_t ch, int deg);     // 0..180，超出夹紧
+
+// 和 Arduino Servo 同样的用法，舵机模块里的轴对象不用改写法
+class HalServo {
+public:
+  bool attach(int8_t pin) { ch_ = hal_servo_attach(pin); return ch_ >= 0; }
+  void write(int deg)     { if (ch_ >= 0) hal_servo_write(ch_, deg); }
+private:
+  int8_t ch_ = -1;
+};
+
+// ---------- 串口 ----------
+// 回调在驱动的事件任务里（主机上在主循环开头），只许搬数据、记计数
+enum HalUartError : uint8_t {
+  HAL_UART_ERR_OVERFLOW,    // 驱动 FIFO / 缓冲溢出
+  HAL_UART_ERR_LINE,        // 帧错误 / 校验位错误 / break
+};
+typedef void (*HalUartRxCb)();
+typedef void (*HalUartErrCb)(HalUartError err);
+
+#define HAL_UART_PORTS  3
+
+bool   hal_uart_begin(uint8_t port, uint32_t baud, int rx_pin, int tx_pin, size_t rx_buf,
+                      HalUartRxCb on_rx, HalUartErrCb on_err);
+size_t hal_uart_read(uint8_t port, uint8_t *buf, size_t n);   // 非阻塞，返回读到的字节数
+size_t hal_uart_write(uint8_t port, const uint8_t *buf, size_t n);
+
+// ---------- I2C（主机模式，语音模块用） ----------
+// 读写都是一整次传输；读寄存器 = 先 write 寄存器号，再 read
+bool   hal_i2c_begin(int sda_pin, int scl_pin);
+bool   hal_i2c_write(uint8_t addr, const uint8_t *buf, size_t n);   // false = NACK / 超时 / 总线错误
+size_t hal_i2c_read(uint8_t addr, uint8_t *buf, size_t n);          // 返回读到的字节数
+
+// ---------- 文件（LittleFS / 主机目录） ----------
+#define HAL_FS_MAX_OPEN  4
+
+typedef int8_t HalFile;               // <0 = 无效
+#define HAL_FILE_NONE  ((HalFile)-1)
+
+bool    hal_fs_begin();
+HalFile hal_fs_open(const char *path);          // 只读
+HalFile hal_fs_open_append(const char *path);   // 追加写，没有就建（串口上传的 .part）
+size_t  hal_fs_read(HalFile f, uint8_t *buf, size_t n);
+size_t  hal_fs_write(HalFile f, const uint8_t *buf, size_t n);
+bool    hal_fs_seek(HalFile f, size_t pos);
+size_t  hal_fs_tell(HalFile f);
+size_t  hal_fs_size(HalFile f);
+void    hal_fs_close(HalFile f);
+bool    hal_fs_remove(const char *path);
+bool    hal_fs_rename(const char *from, const char *to);   // 覆盖已有目标，原子替换
+
+// ---------- 调试输出 ----------
+void hal_log_begin(uint32_t baud);
+void hal_log(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// 日志出口：设了且返回 true 就算已处理（比如实时侧排队交给 IO 核打印），否则直接输出
+typedef bool (*HalLogSink)(const char *text);
+void hal_log_sink(HalLogSink sink);
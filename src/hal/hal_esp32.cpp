@@ -0,0 +1,209 @@
+#ifndef HAL_NATIVE
+
+#include "hal.h"
+#include <Arduino.h>
+#include <Servo.h>
+#include <LittleFS.h>
+#include <Wire.h>
+#include <stdarg.h>
+
+namespace {
+
+static Servo   g_servo[HAL_SERVO_MAX];
+static uint8_t g_servo_n = 0;
+
+// 端口 0 是调试串口（Serial / hal_log），这里只开 1、2
+static HardwareSerial g_uart1(1);
+static HardwareSerial g_uart2(2);
+static HardwareSerial *const g_uart[HAL_UART_PORTS] = { nullptr, &g_uart1, &g_uart2 };
+static HalUartErrCb g_uart_err[HAL_UART_PORTS];
+
+static File g_files[HAL_FS_MAX_OPEN];
+
+static HalLogSink g_log_sink = nullptr;
+
+#define HAL_LOG_TX_BUF  1024    // 调试串口发送缓冲，日志队列按它的空位非阻塞地写
+
+static File *file_at(HalFile f)
+{
+  if (f < 0 || f >= HAL_FS_MAX_OPEN || !g_files[f]) return nullptr;
+  return &g_files[f];
+}
+
+} // namespace
+
+uint32_t hal_millis()             { return millis(); }
+uint32_t hal_micros()             { return micros(); }
+void     hal_delay_ms(uint32_t ms) { delay(ms); }
+
+void hal_gpio_output(uint8_t pin)              { pinMode(pin, OUTPUT); }
+void hal_gpio_write(uint8_t pin, uint8_t level) { digitalWrite(pin, level ? HIGH : LOW); }
+// ESP32 Arduino：digitalRead 对 OUTPUT 引脚可读回当前电平
+int  hal_gpio_read(uint8_t pin)                { return digitalRead(pin); }
+
+int8_t hal_servo_attach(int8_t pin)
+{
+  if (g_servo_n >= HAL_SERVO_MAX) return -1;
+  g_servo[g_servo_n].attach(pin);
+  return (int8_t)g_servo_n++;
+}
+
+void hal_servo_write(int8_t ch, int deg)
+{
+  if (ch < 0 || ch >= g_servo_n) return;
+  g_servo[ch].write(constrain(deg, 0, 180));
+}
+
+bool hal_uart_begin(uint8_t port, uint32_t baud, int rx_pin, int tx_pin, size_t rx_buf,
+                    HalUartRxCb on_rx, HalUartErrCb on_err)
+{
+  if (port >= HAL_UART_PORTS || !g_uart[port]) return false;
+  HardwareSerial &s = *g_uart[port];
+  s.setRxBufferSize(rx_buf);                         // 必须在 begin 之前
+  s.begin(baud, SERIAL_8N1, rx_pin, tx_pin);
+  if (on_rx) s.onReceive(on_rx, false);              // FIFO 满或接收超时都会回调
+  g_uart_err[port] = on_err;
+  if (on_err) {
+    s.onReceiveError([port](hardwareSerial_error_t err) {
+      switch (err) {
+        case UART_BUFFER_FULL_ERROR:
+        case UART_FIFO_OVF_ERROR:
+          g_uart_err[port](HAL_UART_ERR_OVERFLOW);
+          break;
+        case UART_BREAK_ERROR:
+        case UART_FRAME_ERROR:
+        case UART_PARITY_ERROR:
+          g_uart_err[port](HAL_UART_ERR_LINE);
+          break;
+        default:
+          break;
+      }
+    });
+  }
+  return true;
+}
+
+size_t hal_uart_read(uint8_t port, uint8_t *buf, size_t n)
+{
+  if (port >= HAL_UART_PORTS || !g_uart[port]) return 0;
+  HardwareSerial &s = *g_uart[port];
+  int avail = s.available();
+  if (avail <= 0) return 0;
+  if ((size_t)avail < n) n = (size_t)avail;
+  return s.readBytes(buf, n);
+}
+
+size_t hal_uart_write(uint8_t port, const uint8_t *buf, size_t n)
+{
+  if (port >= HAL_UART_PORTS || !g_uart[port]) return 0;
+  return g_uart[port]->write(buf, n);
+}
+
+bool hal_i2c_begin(int sda_pin, int scl_pin)
+{
+  return Wire.begin(sda_pin, scl_pin);
+}
+
+bool hal_i2c_write(uint8_t addr, const uint8_t *buf, size_t n)
+{
+  Wire.beginTransmission(addr);
+  Wire.write(buf, n);
+  return Wire.endTransmission() == 0;
+}
+
+size_t hal_i2c_read(uint8_t addr, uint8_t *buf, size_t n)
+{
+  Wire.requestFrom((int)addr, (int)n);
+  size_t i = 0;
+  while (Wire.available() && i < n) buf[i++] = (uint8_t)Wire.read();
+  while (Wire.available()) Wire.read();   // 多给的丢掉，不留给下一次
+  return i;
+}
+
+bool hal_fs_begin()
+{
+  return LittleFS.begin(true);
+}
+
+static HalFile fs_open(const char *path, const char *mode)
+{
+  for (int i = 0; i < HAL_FS_MAX_OPEN; i++) {
+    if (g_files[i]) continue;
+    g_files[i] = LittleFS.open(path, mode);
+    return g_files[i] ? (HalFile)i : HAL_FILE_NONE;
+  }
+  return HAL_FILE_NONE;
+}
+
+HalFile hal_fs_open(const char *path)        { return fs_open(path, "r"); }
+HalFile hal_fs_open_append(const char *path) { return fs_open(path, "a"); }
+
+size_t hal_fs_read(HalFile f, uint8_t *buf, size_t n)
+{
+  File *p = file_at(f);
+  return p ? p->read(buf, n) : 0;
+}
+
+size_t hal_fs_write(HalFile f, const uint8_t *buf, size_t n)
+{
+  File *p = file_at(f);
+  return p ? p->write(buf, n) : 0;
+}
+
+bool hal_fs_seek(HalFile f, size_t pos)
+{
+  File *p = file_at(f);
+  return p && p->seek(pos);
+}
+
+size_t hal_fs_tell(HalFile f)
+{
+  File *p = file_at(f);
+  return p ? p->position() : 0;
+}
+
+size_t hal_fs_size(HalFile f)
+{
+  File *p = file_at(f);
+  return p ? p->size() : 0;
+}
+
+void hal_fs_close(HalFile f)
+{
+  File *p = file_at(f);
+  if (p) p->close();
+}
+
+bool hal_fs_remove(const char *path)
+{
+  return LittleFS.remove(path);
+}
+
+bool hal_fs_rename(const char *from, const char *to)
+{
+  return LittleFS.rename(from, to);
+}
+
+void hal_log_begin(uint32_t baud)
+{
+  Serial.setTxBufferSize(HAL_LOG_TX_BUF);            // 必须在 begin 之前
+  Serial.begin(baud);
+}
+
+void hal_log(const char *fmt, ...)
+{
+  char buf[256];
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  if (g_log_sink && g_log_sink(buf)) return;
+  Serial.print(buf);
+}
+
+void hal_log_sink(HalLogSink sink)
+{
+  g_log_sink = sink;
+}
+
+#endif // HAL_NATIVE
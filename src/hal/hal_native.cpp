@@ -0,0 +1,392 @@
+#ifdef HAL_NATIVE
+
+/*
+ * 主机（Linux）实现；主循环在 hal_native_main.cpp，接管时钟 / 观察输出的接口见 hal_native.h
+ */
+
+#include "hal_native.h"
+
+#include <chrono>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+#define HAL_NATIVE_GPIO_MAX    64
+#define HAL_NATIVE_INJECT_MAX  1024
+
+static const auto g_t0 = std::chrono::steady_clock::now();
+static bool     g_virtual = false;
+static uint64_t g_virt_us = 0;
+static HalNativeTraceCb g_trace = nullptr;
+
+static uint8_t g_gpio[HAL_NATIVE_GPIO_MAX];
+static int8_t  g_servo_pin[HAL_SERVO_MAX];
+static int16_t g_servo_deg[HAL_SERVO_MAX];
+static uint8_t g_servo_n = 0;
+
+struct UartPort {
+  int          fd = -1;
+  HalUartRxCb  on_rx = nullptr;
+  uint8_t      inject[HAL_NATIVE_INJECT_MAX];   // hal_native_uart_inject 塞进来的，先于 fd 读
+  uint16_t     inject_len = 0;
+  uint16_t     inject_pos = 0;
+};
+static UartPort g_uart[HAL_UART_PORTS];
+
+// I2C 从机假件：每个地址一张寄存器表，写 = 寄存器号 + 数据，读从寄存器指针开始往后
+// 某个寄存器可以排一串值（hal_native_i2c_inject），每次从它开始的读取出一个，排空后回表里的值
+// 真时钟下按总线速率忙等出每次传输的时间（起始 + 地址 + 每字节 9 位），和板子上 Wire 阻塞的时长相当；
+// 虚拟时钟下不耗时
+#define HAL_NATIVE_I2C_DEVS    2
+#define HAL_NATIVE_I2C_SCRIPT  32
+#define HAL_NATIVE_I2C_HZ      100000   // Wire.begin 不给频率时的默认值
+
+struct I2cDev {
+  bool    used = false;
+  uint8_t addr = 0;
+  uint8_t ptr = 0;
+  uint8_t regs[256] = {};
+  uint8_t script_reg = 0;
+  uint8_t script[HAL_NATIVE_I2C_SCRIPT];
+  uint8_t script_len = 0;
+  uint8_t script_pos = 0;
+};
+static I2cDev g_i2c[HAL_NATIVE_I2C_DEVS];
+
+static FILE *g_files[HAL_FS_MAX_OPEN];
+static const char *g_fs_root = "data";
+
+static HalLogSink g_log_sink = nullptr;
+
+static void trace(HalNativeEvent ev, int id, int value)
+{
+  if (g_trace) g_trace(hal_millis(), ev, id, value);
+}
+
+static I2cDev *i2c_dev(uint8_t addr)
+{
+  for (auto &d : g_i2c) {
+    if (d.used && d.addr == addr) return &d;
+  }
+  return nullptr;
+}
+
+static void i2c_bus_time(size_t bytes)
+{
+  if (g_virtual) return;
+  uint32_t us = (uint32_t)((bytes + 1) * 9 * 1000000ull / HAL_NATIVE_I2C_HZ);
+  uint32_t t0 = hal_micros();
+  while (hal_micros() - t0 < us) {}
+}
+
+static FILE *file_at(HalFile f)
+{
+  if (f < 0 || f >= HAL_FS_MAX_OPEN) return nullptr;
+  return g_files[f];
+}
+
+static void full_path(const char *path, char *out, size_t cap)
+{
+  snprintf(out, cap, "%s%s%s", g_fs_root, path[0] == '/' ? "" : "/", path);
+}
+
+static HalFile fs_open(const char *path, const char *mode)
+{
+  char full[256];
+  full_path(path, full, sizeof(full));
+  for (int i = 0; i < HAL_FS_MAX_OPEN; i++) {
+    if (g_files[i]) continue;
+    g_files[i] = fopen(full, mode);
+    return g_files[i] ? (HalFile)i : HAL_FILE_NONE;
+  }
+  return HAL_FILE_NONE;
+}
+
+} // namespace
+
+uint32_t hal_millis()
+{
+  using namespace std::chrono;
+  if (g_virtual) return (uint32_t)(g_virt_us / 1000);
+  return (uint32_t)duration_cast<milliseconds>(steady_clock::now() - g_t0).count();
+}
+
+uint32_t hal_micros()
+{
+  using namespace std::chrono;
+  if (g_virtual) return (uint32_t)g_virt_us;
+  return (uint32_t)duration_cast<microseconds>(steady_clock::now() - g_t0).count();
+}
+
+// 虚拟时钟下只往前拨，不真睡
+void hal_delay_ms(uint32_t ms)
+{
+  if (g_virtual) g_virt_us += (uint64_t)ms * 1000;
+  else           std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void hal_gpio_output(uint8_t pin)
+{
+  if (pin < HAL_NATIVE_GPIO_MAX) trace(HAL_NATIVE_EV_GPIO_OUTPUT, pin, 0);
+}
+
+void hal_gpio_write(uint8_t pin, uint8_t level)
+{
+  if (pin >= HAL_NATIVE_GPIO_MAX) return;
+  level = level ? HAL_HIGH : HAL_LOW;
+  if (g_gpio[pin] != level) trace(HAL_NATIVE_EV_GPIO, pin, level);
+  g_gpio[pin] = level;
+}
+
+int hal_gpio_read(uint8_t pin)
+{
+  return pin < HAL_NATIVE_GPIO_MAX ? g_gpio[pin] : HAL_LOW;
+}
+
+int8_t hal_servo_attach(int8_t pin)
+{
+  if (g_servo_n >= HAL_SERVO_MAX) return -1;
+  g_servo_pin[g_servo_n] = pin;
+  g_servo_deg[g_servo_n] = -1;
+  return (int8_t)g_servo_n++;
+}
+
+void hal_servo_write(int8_t ch, int deg)
+{
+  if (ch < 0 || ch >= g_servo_n) return;
+  if (deg < 0) deg = 0;
+  if (deg > 180) deg = 180;
+  if (g_servo_deg[ch] != deg) trace(HAL_NATIVE_EV_SERVO, g_servo_pin[ch], deg);
+  g_servo_deg[ch] = (int16_t)deg;
+}
+
+// 串口接到 HAL_UART<port> 指向的路径；没设就当没接线（写出去的丢掉）
+bool hal_uart_begin(uint8_t port, uint32_t baud, int rx_pin, int tx_pin, size_t rx_buf,
+                    HalUartRxCb on_rx, HalUartErrCb on_err)
+{
+  (void)baud; (void)rx_pin; (void)tx_pin; (void)rx_buf; (void)on_err;
+  if (port >= HAL_UART_PORTS) return false;
+  UartPort &u = g_uart[port];
+  u.on_rx = on_rx;
+
+  char name[16];
+  snprintf(name, sizeof(name), "HAL_UART%u", port);
+  const char *path = getenv(name);
+  if (!path || u.fd >= 0) return true;
+  u.fd = open(path, O_RDWR | O_NONBLOCK | O_NOCTTY);
+  if (u.fd < 0) u.fd = open(path, O_RDONLY | O_NONBLOCK);
+  if (u.fd < 0) {
+    perror(path);
+    return false;
+  }
+  return true;
+}
+
+size_t hal_uart_read(uint8_t port, uint8_t *buf, size_t n)
+{
+  if (port >= HAL_UART_PORTS) return 0;
+  UartPort &u = g_uart[port];
+  if (u.inject_pos < u.inject_len) {
+    size_t k = u.inject_len - u.inject_pos;
+    if (k > n) k = n;
+    memcpy(buf, &u.inject[u.inject_pos], k);
+    u.inject_pos = (uint16_t)(u.inject_pos + k);
+    return k;
+  }
+  if (u.fd < 0) return 0;
+  ssize_t r = read(u.fd, buf, n);
+  return r > 0 ? (size_t)r : 0;
+}
+
+size_t hal_uart_write(uint8_t port, const uint8_t *buf, size_t n)
+{
+  if (port >= HAL_UART_PORTS || g_uart[port].fd < 0) return n;
+  ssize_t r = write(g_uart[port].fd, buf, n);
+  return r > 0 ? (size_t)r : 0;
+}
+
+bool hal_i2c_begin(int sda_pin, int scl_pin)
+{
+  (void)sda_pin; (void)scl_pin;
+  return true;
+}
+
+// 总线上没有这个地址（没 inject 过）就当 NACK，和模块没接一样
+bool hal_i2c_write(uint8_t addr, const uint8_t *buf, size_t n)
+{
+  I2cDev *d = i2c_dev(addr);
+  i2c_bus_time(d ? n : 0);
+  if (!d) return false;
+  if (n == 0) return true;
+  d->ptr = buf[0];
+  for (size_t i = 1; i < n; i++) d->regs[d->ptr++] = buf[i];
+  return true;
+}
+
+size_t hal_i2c_read(uint8_t addr, uint8_t *buf, size_t n)
+{
+  I2cDev *d = i2c_dev(addr);
+  i2c_bus_time(d ? n : 0);
+  if (!d) return 0;
+  for (size_t i = 0; i < n; i++) {
+    uint8_t reg = d->ptr++;
+    if (reg == d->script_reg && d->script_pos < d->script_len) buf[i] = d->script[d->script_pos++];
+    else                                                       buf[i] = d->regs[reg];
+  }
+  return n;
+}
+
+bool hal_fs_begin()
+{
+  const char *root = getenv("HAL_FS_ROOT");
+  if (root) g_fs_root = root;
+  return access(g_fs_root, R_OK) == 0;
+}
+
+HalFile hal_fs_open(const char *path)        { return fs_open(path, "rb"); }
+HalFile hal_fs_open_append(const char *path) { return fs_open(path, "ab"); }
+
+size_t hal_fs_read(HalFile f, uint8_t *buf, size_t n)
+{
+  FILE *p = file_at(f);
+  return p ? fread(buf, 1, n, p) : 0;
+}
+
+size_t hal_fs_write(HalFile f, const uint8_t *buf, size_t n)
+{
+  FILE *p = file_at(f);
+  return p ? fwrite(buf, 1, n, p) : 0;
+}
+
+bool hal_fs_seek(HalFile f, size_t pos)
+{
+  FILE *p = file_at(f);
+  return p && fseek(p, (long)pos, SEEK_SET) == 0;
+}
+
+size_t hal_fs_tell(HalFile f)
+{
+  FILE *p = file_at(f);
+  long at = p ? ftell(p) : -1;
+  return at > 0 ? (size_t)at : 0;
+}
+
+size_t hal_fs_size(HalFile f)
+{
+  FILE *p = file_at(f);
+  if (!p) return 0;
+  long at = ftell(p);
+  fseek(p, 0, SEEK_END);
+  long end = ftell(p);
+  fseek(p, at, SEEK_SET);
+  return end > 0 ? (size_t)end : 0;
+}
+
+void hal_fs_close(HalFile f)
+{
+  FILE *p = file_at(f);
+  if (!p) return;
+  fclose(p);
+  g_files[f] = nullptr;
+}
+
+bool hal_fs_remove(const char *path)
+{
+  char full[256];
+  full_path(path, full, sizeof(full));
+  return remove(full) == 0;
+}
+
+bool hal_fs_rename(const char *from, const char *to)
+{
+  char a[256], b[256];
+  full_path(from, a, sizeof(a));
+  full_path(to, b, sizeof(b));
+  return rename(a, b) == 0;
+}
+
+void hal_log_begin(uint32_t baud)
+{
+  (void)baud;
+  setvbuf(stdout, nullptr, _IOLBF, 0);
+}
+
+void hal_log(const char *fmt, ...)
+{
+  char buf[256];
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  if (g_log_sink && g_log_sink(buf)) return;
+  fputs(buf, stdout);
+}
+
+void hal_log_sink(HalLogSink sink)
+{
+  g_log_sink = sink;
+}
+
+void hal_native_use_virtual_clock()
+{
+  g_virtual = true;
+  g_virt_us = 0;
+}
+
+void hal_native_advance_us(uint32_t us)
+{
+  g_virt_us += us;
+}
+
+void hal_native_on_trace(HalNativeTraceCb cb)
+{
+  g_trace = cb;
+}
+
+bool hal_native_uart_inject(uint8_t port, const uint8_t *data, size_t n)
+{
+  if (port >= HAL_UART_PORTS) return false;
+  UartPort &u = g_uart[port];
+  if (u.inject_pos == u.inject_len) u.inject_pos = u.inject_len = 0;
+  if (u.inject_len + n > sizeof(u.inject)) return false;
+  memcpy(&u.inject[u.inject_len], data, n);
+  u.inject_len = (uint16_t)(u.inject_len + n);
+  return true;
+}
+
+bool hal_native_i2c_inject(uint8_t addr, uint8_t reg, const uint8_t *vals, size_t n)
+{
+  I2cDev *d = i2c_dev(addr);
+  for (auto &e : g_i2c) {
+    if (d) break;
+    if (!e.used) { d = &e; d->used = true; d->addr = addr; }
+  }
+  if (!d) return false;
+  if (d->script_pos == d->script_len || d->script_reg != reg) d->script_pos = d->script_len = 0;
+  if (d->script_len + n > sizeof(d->script)) return false;
+  d->script_reg = reg;
+  memcpy(&d->script[d->script_len], vals, n);
+  d->script_len = (uint8_t)(d->script_len + n);
+  return true;
+}
+
+// 有数据可读的串口调一次接收回调，和 ESP32 上事件任务的节奏差不多
+void hal_native_uart_poll()
+{
+  for (int i = 0; i < HAL_UART_PORTS; i++) {
+    UartPort &u = g_uart[i];
+    if (!u.on_rx) continue;
+    if (u.inject_pos < u.inject_len) { u.on_rx(); continue; }
+    if (u.fd < 0) continue;
+    pollfd p = { u.fd, POLLIN, 0 };
+    if (poll(&p, 1, 0) > 0 && (p.revents & POLLIN)) u.on_rx();
+  }
+}
+
+#endif // HAL_NATIVE
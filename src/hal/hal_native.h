@@ -0,0 +1,29 @@
+#pragma once
+
+#include "hal.h"
+
+/* =========================
+ * 主机实现独有的接口（只在 HAL_NATIVE 下有）
+ * 主机程序（hal_native_main.cpp、tools/show_sim）用来接管时钟、喂串口 / I2C、观察输出
+ * ========================= */
+
+// 切到虚拟时钟：从 0 开始，之后只随 hal_native_advance_us / hal_delay_ms 前进
+void hal_native_use_virtual_clock();
+void hal_native_advance_us(uint32_t us);
+
+// 输出变化回调：GPIO 设为输出 / 电平变化、舵机角度变化（id = 引脚）
+enum HalNativeEvent : uint8_t {
+  HAL_NATIVE_EV_GPIO_OUTPUT,
+  HAL_NATIVE_EV_GPIO,
+  HAL_NATIVE_EV_SERVO,
+};
+typedef void (*HalNativeTraceCb)(uint32_t ms, HalNativeEvent ev, int id, int value);
+void hal_native_on_trace(HalNativeTraceCb cb);
+
+// 往串口接收端塞字节（先于 HAL_UARTn 文件读出），下次 hal_native_uart_poll 触发接收回调
+bool hal_native_uart_inject(uint8_t port, const uint8_t *data, size_t n);
+void hal_native_uart_poll();    // 主循环每圈调一次
+
+// I2C 从机假件：地址 addr 的寄存器 reg 排上一串值，从 reg 开始的每次读取出一个，排空后回寄存器表（没写过是 0）
+// 第一次 inject 才把这个地址挂上总线，之前的读写都是 NACK（语音模块没接）
+bool hal_native_i2c_inject(uint8_t addr, uint8_t reg, const uint8_t *vals, size_t n);
@@ -0,0 +1,102 @@
+#ifdef HAL_NATIVE
+
+/*
+ * 主机上的 Arduino 主循环：pio run -e native，然后运行 .pio/build/native/program
+ *
+ * 环境变量：
+ *   HAL_FS_ROOT=dir     文件系统根目录（默认 data，和 LittleFS 镜像同一份）
+ *   HAL_UART2=path      命令串口接到一个 pty / 管道 / 文件，例如 socat 建的 pty 配 link_host
+ *   HAL_RUN_MS=n        跑 n 毫秒后退出（默认一直跑，Ctrl-C 退出）
+ *   HAL_TRACE=1         GPIO / 舵机变化打印到 stderr
+ *   HAL_ASR=id@ms,...   语音模块在第 ms 毫秒“识别出”词条 id，例如 HAL_ASR=0x05@1000,0x0C@9000
+ *                       （不设就当模块没接，I2C 读写都 NACK）
+ *
+ * 要虚拟时钟、批量回放演出用 tools/show_sim（不链接这个文件）。
+ */
+
+#include "hal_native.h"
+#include "../ASR/ASR_module.h"
+
+#include <chrono>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+void setup();
+void loop();
+
+namespace {
+
+static volatile sig_atomic_t g_quit = 0;
+
+static void on_signal(int) { g_quit = 1; }
+
+// HAL_ASR 的脚本：到点往语音模块的识别结果寄存器里排一个词条
+#define ASR_SCRIPT_MAX  16
+
+struct AsrCue {
+  uint32_t ms;
+  uint8_t  id;
+};
+static AsrCue  g_asr[ASR_SCRIPT_MAX];
+static uint8_t g_asr_n = 0;
+static uint8_t g_asr_next = 0;
+
+static void asr_parse(const char *s)
+{
+  while (s && *s && g_asr_n < ASR_SCRIPT_MAX) {
+    char *end;
+    AsrCue &c = g_asr[g_asr_n];
+    c.id = (uint8_t)strtoul(s, &end, 0);
+    c.ms = *end == '@' ? (uint32_t)strtoul(end + 1, &end, 10) : 0;
+    g_asr_n++;
+    s = *end == ',' ? end + 1 : nullptr;
+  }
+}
+
+static void asr_service(uint32_t now)
+{
+  while (g_asr_next < g_asr_n && (int32_t)(now - g_asr[g_asr_next].ms) >= 0) {
+    hal_native_i2c_inject(I2C_ADDR, ASR_RESULT_ADDR, &g_asr[g_asr_next].id, 1);
+    g_asr_next++;
+  }
+}
+
+static void print_trace(uint32_t ms, HalNativeEvent ev, int id, int value)
+{
+  switch (ev) {
+    case HAL_NATIVE_EV_GPIO_OUTPUT: fprintf(stderr, "%8u gpio %d output\n", ms, id);     break;
+    case HAL_NATIVE_EV_GPIO:        fprintf(stderr, "%8u gpio %d %d\n", ms, id, value);  break;
+    case HAL_NATIVE_EV_SERVO:       fprintf(stderr, "%8u servo %d %d\n", ms, id, value); break;
+  }
+}
+
+} // namespace
+
+// setup 一次，loop 一直转，每圈让出 1ms
+int main()
+{
+  const char *t = getenv("HAL_TRACE");
+  if (t && t[0] == '1') hal_native_on_trace(print_trace);
+  const char *run = getenv("HAL_RUN_MS");
+  uint32_t run_ms = run ? (uint32_t)strtoul(run, nullptr, 10) : 0;
+  asr_parse(getenv("HAL_ASR"));
+  if (g_asr_n) {
+    uint8_t none = 0;   // 先把模块挂上总线，识别结果 0 = 没识别到
+    hal_native_i2c_inject(I2C_ADDR, ASR_RESULT_ADDR, &none, 1);
+  }
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+
+  setup();
+  while (!g_quit && (run_ms == 0 || hal_millis() < run_ms)) {
+    asr_service(hal_millis());
+    hal_native_uart_poll();
+    loop();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return 0;
+}
+
+#endif // HAL_NATIVE
@@ -1,152 +1,111 @@
-#include <Arduino.h>
+#include "hal/hal.h"
 #include "uart/uart_in.h"
-#include "webservo/web.h"
 #include "servo/servo_in.h"
 #include "ws2812/ws2812.h"
-#include "ASR/ASR_module.h"
 #include "sys/sys.h"
+#include "sys/cores.h"
+#include "sys/bus.h"
 #include "config/config.h"
+#include "stream/stream_in.h"
+#include "stream/led_in.h"
+#include "upload/upload.h"
+#include "show/show.h"
+#include "ASR/ASR_module.h"
 
-#define bootraid  115200
-#define TX 38
-#define RX 39
-
+// WiFi / 指标只在板子上有；主机构建（HAL_NATIVE）的语音模块接 I2C 假件（hal_native.h）
+#ifndef HAL_NATIVE
+#include <Arduino.h>
+#include "webservo/web.h"
+#include "metrics/metrics.h"
+#endif
 
 ASR_MOUDLE asr;
 uint8_t result = 0;
+uint16_t uart_cmd = 0;
+
+static void io_step();
+extern const BusRoute k_routes[BUS_EV_COUNT];
 
 
 void setup() {
-  Serial.begin(115200);                     // 调试串口
+  hal_log_begin(115200);                     // 调试串口
   config_init();
   Servo_init();
   ws2812_init();
   ws2812_staute_green();
   sys_init();
-  // wifi_init();
-  // 初始化语音 UART
+#ifndef HAL_NATIVE
+  wifi_init();   // AP + Web：/ws 控制与遥测、/api/*、网页资源、HTTP 上传、/metrics、Art-Net/E1.31
+#endif
+  // 初始化语音模块（I2C）
   asr.ASR_init();
-  Serial.println("UART In ready");
-  Serial.println(" power by zdc");
-  
+  // 初始化命令 UART（第二路命令源，和 ASR 同一套分发）
+  uartInInit(UART_IN_BAUD, UART_IN_RX_PIN, UART_IN_TX_PIN);
+  stream_in_init();
+  led_in_init();
+  upload_init();
+#ifndef HAL_NATIVE
+  metrics_init();
+#endif
+  hal_log("UART In ready\n");
+  hal_log(" power by zdc\n");
+  cores_start_io(io_step);   // 命令输入 / 日志挪到 0 号核，loop 只剩实时部分
 }
 
+// 1 号核：只做实时的事，命令从总线上取
 void loop() {
+    cores_rt_begin();
+#ifndef HAL_NATIVE
+    metrics_loop_tick();
+#endif
+    bus_service(k_routes, BUS_EV_COUNT);
+    uartInServiceRt();
     Servo_Update();  // 必须常驻
     ws2812_is_running();
     sys_service();
+    stream_in_service();
+#ifndef HAL_NATIVE
+    web_service();
+#endif
+    cores_rt_end();
+}
 
+// 0 号核：语音 / 串口命令解析成事件发到总线，不碰舵机和灯带
+static void io_step() {
     result = asr.rec_recognition();  //返回识别结果，即识别到的词条编号
-    if(result != 0){
-      if(result == 0x01) {
-        Servo_act_firest();
-        biz_pulse_led(Leaser_pin_1,Leaser_pin_2,Leaser_pin_3);
-        ws2812_demo1();
-        Serial.println("1");
-      }
-      else if(result == 0x02) {
-        Servo_PlayZero();
-        Serial.println("2");
-      }
-      else if(result == 0x03) {
-        Servo_PlayDemo();
-        Serial.println("3");
-      }
-      else if(result == 0x04) {
-        Servo_act_test1();
-        Serial.println("4");
-      }
-
-      else if(result == 0x05) { 
-        Servo_act_air_warning(); 
-        biz_start_air_warning(); // 对应空气预警
-        Serial.println("5");
-      }
-
-      else if(result == 0x06) { 
-        Servo_act_report_crash(); 
-        biz_start_crash_report(); // 对应坠毁报告
-        Serial.println("6");
-      }
-
-      else if(result == 0x07) { 
-        Servo_act_gas_wave_need_cores_map(); 
-        biz_start_gas_wave_scan(Leaser_pin_1,Leaser_pin_2,Leaser_pin_3); // 对应气体波形扫描（已包含引脚操作）
-        Serial.println("7");
-      }
-
-      else if(result == 0x08) { 
-        Servo_act_dismantle_god_myth(); 
-        biz_start_dismantle_myth(); // 对应拆解谜团
-        Serial.println("8");
-      }
-
-      else if(result == 0x09) { 
-        Servo_act_blow_the_box_fast(); 
-        biz_start_blow_box(Leaser_pin_1,Leaser_pin_2,Leaser_pin_3); // 对应直接炸箱子
-        Serial.println("9");
-      }
-
-      else if(result == 0x0B) { 
-        Servo_act_emergency_oxygen(); 
-        biz_start_emergency_oxygen(); // 对应应急制氧
-        Serial.println("11");
-      }
-
-      else if(result == 0x0C) { 
-        Servo_act_ai_party_dizzy(); 
-        biz_start_ai_party_dizzy(); // 对应派对/眩晕
-        Serial.println("12");
-      }
-
-      else if(result == 0x0D) { 
-        Servo_act_party_glitch_spasm(); 
-        biz_start_glitch_spasm(); // 对应抽风乱甩（内部包含彩虹灯效）
-        Serial.println("13");
-      }
-
-      else if(result == 0x0E) { 
-        Servo_act_point_3_knobs_20s(); 
-        biz_start_point_knobs(Leaser_pin_1,Leaser_pin_2,Leaser_pin_3); // 对应旋钮分析提示
-        Serial.println("14");
-      }
-
-      else if(result == 0x0F) { 
-        Servo_act_doubt_not_sure_6s(); 
-        biz_start_doubt(); // 对应怀疑状态
-        Serial.println("15");
-      }
-
-      else if(result == 0x10) { 
-        Servo_act_nav_abandoned_port(); 
-        biz_start_nav_port(); // 对应导航废弃港口
-        Serial.println("16");
-      }
-
-      else if(result == 0x11) { 
-        Servo_act_nervous_apology_6s();
-        biz_start_nervous_apology(Radar_pin); // 对应紧张道歉
-        Serial.println("17");
-      }
-
-      else if(result == 0x12) { 
-        Servo_act_accuse_god_15s(); 
-        biz_start_accusation(); // 对应指责情绪
-        Serial.println("18");
-      }
+    if(result != 0) bus_publish(BUS_SRC_ASR, BUS_EV_SHOW, result);
+
+    // UART 命令：每帧已校验 CRC，映射成词条编号后走同一张表（映射不了的记 unknown）
+    while(readCmdFromUART(uart_cmd)){
+      bus_publish(BUS_SRC_UART, BUS_EV_SHOW, uartCmdToVoiceId(uart_cmd));
+    }
+#ifndef HAL_NATIVE
+    web_io_service();   // 遥测广播 / 清理客户端：网络操作都在这边
+    metrics_service();
+#endif
+}
 
-      else if(result == 0x13) { 
-        Servo_act_point_power_source_2s(); 
-        biz_start_point_power(); // 对应电力装置指向
-        Serial.println("19");
-      }
+static bool on_show(const BusEvent &ev)
+{
+  return show_run(ev.id);
+}
 
-      else if(result == 0x14) { 
-        Servo_act_overload_need2_override_urgent_15s(); 
-        biz_start_overload_override(); // 对应装置超载覆写
-        Serial.println("20");
-      }
-  }
+static bool on_pose(const BusEvent &ev)
+{
+  Servo_MoveTo(ev.off, ev.mask, ev.dur_ms);
+  return true;
 }
 
+static bool on_stop(const BusEvent &)
+{
+  Servo_Stop();
+  return true;
+}
 
+// 事件种类 -> 处理函数，第 i 行就是 BusKind i
+constexpr BusRoute k_routes[BUS_EV_COUNT] = {
+  { BUS_EV_SHOW, on_show },
+  { BUS_EV_POSE, on_pose },
+  { BUS_EV_STOP, on_stop },
+};
+static_assert(bus_table_dense(k_routes), "k_routes row i must have kind i");
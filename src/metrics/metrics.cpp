@@ -0,0 +1,260 @@
+#include "metrics.h"
+#include <atomic>
+#include <stdarg.h>
+#include "../sys/sys.h"
+#include "../sys/cores.h"
+#include "../sys/bus.h"
+#include "../servo/servo_in.h"
+#include "../ws2812/ws2812.h"
+#include "../ws2812/ws2812_motion.h"
+#include "../ASR/ASR_module.h"
+#include "../uart/uart_in.h"
+#include "../stream/led_rx.h"
+
+namespace {
+
+// 窗口结算结果（loop 任务写，其他任务读）
+struct LoopMetrics {
+  std::atomic<uint32_t> loop_hz{0};          // 上个窗口的 loop 频率
+  std::atomic<uint32_t> loop_worst_us{0};    // 上个窗口里最长的一轮
+  std::atomic<uint32_t> loop_worst_ever_us{0};
+  std::atomic<uint32_t> loop_slow{0};        // 超过 20ms（舵机一帧）的轮数，累计
+  std::atomic<uint32_t> servo_gap_us{0};     // 上个窗口里播放动作时两次 Servo_Update 的最大间隔
+  std::atomic<uint32_t> servo_gap_ever_us{0};
+  std::atomic<uint32_t> led_fps{0};          // 上个窗口的 WS2812 推送帧率
+  std::atomic<uint32_t> uptime_s{0};
+};
+
+static LoopMetrics g_m;
+
+// 只在 loop 任务里用
+static uint32_t g_last_us = 0;
+static uint32_t g_win_start_us = 0;
+static uint32_t g_win_count = 0;
+static uint32_t g_win_worst_us = 0;
+static uint32_t g_win_servo_gap_us = 0;
+static uint32_t g_win_led_frames = 0;
+
+#define METRICS_SLOW_LOOP_US  20000
+
+// 要看栈高水位的任务（按名字查，不存在的跳过）
+static const char *const k_tasks[] = { "loopTask", "io_task", "async_tcp", "uart_event_task", "arduino_events" };
+
+struct Out {
+  char  *buf;
+  size_t cap;
+  size_t len;
+};
+
+static void put(Out &o, const char *fmt, ...)
+{
+  if (o.len >= o.cap) return;
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(o.buf + o.len, o.cap - o.len, fmt, ap);
+  va_end(ap);
+  if (n < 0) return;
+  o.len += (size_t)n;
+  if (o.len >= o.cap) o.len = o.cap - 1;   // 截断
+}
+
+} // namespace
+
+void metrics_init()
+{
+  g_last_us = g_win_start_us = micros();
+  g_win_led_frames = ws2812_frames_pushed();
+}
+
+void metrics_loop_tick()
+{
+  uint32_t now = micros();
+  uint32_t dt = now - g_last_us;
+  g_last_us = now;
+
+  g_win_count++;
+  if (dt > g_win_worst_us) g_win_worst_us = dt;
+  if (dt > METRICS_SLOW_LOOP_US) g_m.loop_slow.fetch_add(1, std::memory_order_relaxed);
+  // 舵机帧间隔：只看正在播放动作的轮（每轮一次 Servo_Update），空闲时 loop 慢一点无所谓
+  if (Servo_IsBusy() && dt > g_win_servo_gap_us) g_win_servo_gap_us = dt;
+
+  uint32_t el = now - g_win_start_us;
+  if (el < (uint32_t)METRICS_WINDOW_MS * 1000) return;
+
+  // 窗口结算
+  uint32_t frames = ws2812_frames_pushed();
+  g_m.loop_hz.store((uint32_t)((uint64_t)g_win_count * 1000000 / el), std::memory_order_relaxed);
+  g_m.loop_worst_us.store(g_win_worst_us, std::memory_order_relaxed);
+  if (g_win_worst_us > g_m.loop_worst_ever_us.load(std::memory_order_relaxed)) {
+    g_m.loop_worst_ever_us.store(g_win_worst_us, std::memory_order_relaxed);
+  }
+  g_m.servo_gap_us.store(g_win_servo_gap_us, std::memory_order_relaxed);
+  if (g_win_servo_gap_us > g_m.servo_gap_ever_us.load(std::memory_order_relaxed)) {
+    g_m.servo_gap_ever_us.store(g_win_servo_gap_us, std::memory_order_relaxed);
+  }
+  g_m.led_fps.store((uint32_t)((uint64_t)(frames - g_win_led_frames) * 1000000 / el), std::memory_order_relaxed);
+  g_m.uptime_s.store(millis() / 1000, std::memory_order_relaxed);
+
+  g_win_led_frames = frames;
+  g_win_start_us = now;
+  g_win_count = 0;
+  g_win_worst_us = 0;
+  g_win_servo_gap_us = 0;
+}
+
+size_t metrics_format(char *buf, size_t cap)
+{
+  if (cap == 0) return 0;
+  Out o = { buf, cap, 0 };
+  buf[0] = '\0';
+
+  put(o, "uptime_s %u\n",           (unsigned)g_m.uptime_s.load(std::memory_order_relaxed));
+  put(o, "loop_hz %u\n",            (unsigned)g_m.loop_hz.load(std::memory_order_relaxed));
+  put(o, "loop_worst_us %u\n",      (unsigned)g_m.loop_worst_us.load(std::memory_order_relaxed));
+  put(o, "loop_worst_ever_us %u\n", (unsigned)g_m.loop_worst_ever_us.load(std::memory_order_relaxed));
+  put(o, "loop_slow_total %u\n",    (unsigned)g_m.loop_slow.load(std::memory_order_relaxed));
+  put(o, "servo_gap_us %u\n",       (unsigned)g_m.servo_gap_us.load(std::memory_order_relaxed));
+  put(o, "servo_gap_ever_us %u\n",  (unsigned)g_m.servo_gap_ever_us.load(std::memory_order_relaxed));
+
+  const CoreStats &cs = cores_stats();
+  put(o, "core_split %u\n",                 (unsigned)cs.split);
+  put(o, "core_busy_pct{core=\"0\"} %u\n",  (unsigned)cs.busy_pct[0]);
+  put(o, "core_busy_pct{core=\"1\"} %u\n",  (unsigned)cs.busy_pct[1]);
+  put(o, "core_log_lines_total %u\n",       (unsigned)cs.log_lines);
+  put(o, "core_log_drops_total %u\n",       (unsigned)cs.log_drops);
+
+  for (uint8_t i = 0; i < BUS_SRC_COUNT; i++) {
+    const BusSourceStats &b = bus_stats((BusSource)i);
+    const char *src = bus_source_name((BusSource)i);
+    put(o, "bus_published_total{src=\"%s\"} %u\n",  src, (unsigned)b.published);
+    put(o, "bus_dropped_total{src=\"%s\"} %u\n",    src, (unsigned)b.dropped);
+    put(o, "bus_dispatched_total{src=\"%s\"} %u\n", src, (unsigned)b.dispatched);
+    put(o, "bus_unknown_total{src=\"%s\"} %u\n",    src, (unsigned)b.unknown);
+    put(o, "bus_latency_max_ms{src=\"%s\"} %u\n",   src, (unsigned)b.lat_max_ms);
+  }
+
+  put(o, "heap_free %u\n",          (unsigned)ESP.getFreeHeap());
+  put(o, "heap_min_free %u\n",      (unsigned)ESP.getMinFreeHeap());
+  put(o, "heap_largest_block %u\n", (unsigned)ESP.getMaxAllocHeap());
+
+  for (const char *name : k_tasks) {
+    TaskHandle_t h = xTaskGetHandle(name);
+    if (!h) continue;
+    put(o, "stack_free_min{task=\"%s\"} %u\n", name, (unsigned)uxTaskGetStackHighWaterMark(h));
+  }
+
+  SysPoolInfo pools[SYS_POOL_COUNT];
+  sys_pool_stats(pools);
+  for (const auto &p : pools) {
+    put(o, "sys_pool_used{pool=\"%s\"} %u\n", p.name, p.used);
+    put(o, "sys_pool_cap{pool=\"%s\"} %u\n",  p.name, p.cap);
+    put(o, "sys_pool_peak{pool=\"%s\"} %u\n", p.name, p.peak);
+    put(o, "sys_pool_full_total{pool=\"%s\"} %u\n", p.name, (unsigned)p.full);
+  }
+
+  const AsrI2cStats &asr = asr_i2c_stats();
+  put(o, "asr_i2c_polls_total %u\n",        (unsigned)asr.polls);
+  put(o, "asr_i2c_write_errors_total %u\n", (unsigned)asr.write_errors);
+  put(o, "asr_i2c_read_errors_total %u\n",  (unsigned)asr.read_errors);
+
+  const UartInStats &u = uartInStats();
+  put(o, "uart_crc_errors_total %u\n",     (unsigned)u.crc_errors);
+  put(o, "uart_framing_errors_total %u\n", (unsigned)u.framing_errors);
+  put(o, "uart_overflows_total %u\n",      (unsigned)(u.ring_overflows + u.hw_overflows));
+  put(o, "uart_rt_drops_total %u\n",       (unsigned)u.rt_drops);
+
+  put(o, "ws2812_fps %u\n",          (unsigned)g_m.led_fps.load(std::memory_order_relaxed));
+  put(o, "ws2812_frames_rendered_total %u\n", (unsigned)ws2812_frames_rendered());
+  put(o, "ws2812_frames_pushed_total %u\n",   (unsigned)ws2812_frames_pushed());
+
+  const WsRenderStats &lr = ws_render_stats();
+  put(o, "ws2812_mode_sets_total %u\n",           (unsigned)lr.set_calls);
+  put(o, "ws2812_mode_sets_applied_total %u\n",   (unsigned)lr.sets_applied);
+  put(o, "ws2812_mode_sets_avoided_total %u\n",   (unsigned)(lr.sets_unchanged + lr.sets_coalesced));
+
+  put(o, "ws2812_motion_worst_us %u\n", (unsigned)ws2812_motion_stats().worst_us);
+
+  const Ws2812PowerStats &pw = ws2812_power_stats();
+  put(o, "ws2812_power_budget_ma %u\n",          (unsigned)ws2812_power_budget());
+  put(o, "ws2812_power_est_ma %u\n",             (unsigned)pw.last_est_ma);
+  put(o, "ws2812_power_peak_est_ma %u\n",        (unsigned)pw.peak_est_ma);
+  put(o, "ws2812_power_scale %u\n",              (unsigned)pw.last_scale);
+  put(o, "ws2812_power_limited_frames_total %u\n", (unsigned)pw.frames_limited);
+  put(o, "ws2812_power_limit_events_total %u\n", (unsigned)pw.limit_events);
+
+  const Ws2812ClipStats &cl = ws2812_clip_stats();
+  put(o, "ws2812_clip_active %u\n",          (unsigned)cl.active);
+  put(o, "ws2812_clip_started_total %u\n",   (unsigned)cl.started);
+  put(o, "ws2812_clip_frames_total %u\n",    (unsigned)cl.frames);
+  put(o, "ws2812_clip_skipped_total %u\n",   (unsigned)cl.skipped);
+  put(o, "ws2812_clip_errors_total %u\n",    (unsigned)cl.errors);
+
+  const LedRxStats &li = led_rx_stats();
+  put(o, "led_in_active %u\n",                 (unsigned)li.active);
+  put(o, "led_in_packets_total %u\n",          (unsigned)li.packets);
+  put(o, "led_in_bad_packets_total %u\n",      (unsigned)li.bad_packets);
+  put(o, "led_in_frames_total %u\n",           (unsigned)li.frames);
+  put(o, "led_in_played_total %u\n",           (unsigned)li.played);
+  put(o, "led_in_dropped_total{reason=\"late\"} %u\n",       (unsigned)li.late_drops);
+  put(o, "led_in_dropped_total{reason=\"incomplete\"} %u\n", (unsigned)li.incomplete);
+  put(o, "led_in_dropped_total{reason=\"overflow\"} %u\n",   (unsigned)li.overflow_drops);
+  put(o, "led_in_dropped_total{reason=\"skipped\"} %u\n",    (unsigned)li.skipped);
+  put(o, "led_in_dropped_total{reason=\"contended\"} %u\n",  (unsigned)li.contended);
+  put(o, "led_in_underruns_total %u\n",        (unsigned)li.underruns);
+  put(o, "led_in_period_ms %u\n",              (unsigned)li.period_ms);
+  put(o, "led_in_depth %u\n",                  (unsigned)li.depth);
+
+  const WsOutStats &lo = ws_out_stats();
+  put(o, "ws2812_tx_deferred_total %u\n", (unsigned)lo.frames_deferred);
+  put(o, "ws2812_tx_errors_total %u\n",   (unsigned)lo.tx_errors);
+  put(o, "ws2812_tx_failed_total %u\n",   (unsigned)lo.frames_failed);
+  put(o, "ws2812_tx_us %u\n",             (unsigned)lo.last_tx_us);
+  put(o, "ws2812_tx_strips %u\n",         (unsigned)lo.strips);
+
+  return o.len;
+}
+
+// 串口输出中的 metrics 文本：每轮只写发送缓冲放得下的部分，和日志队列一样不在 IO 核上阻塞
+static char   g_dump[METRICS_TEXT_MAX];
+static size_t g_dump_len = 0;
+static size_t g_dump_off = 0;
+
+static void dump_drain()
+{
+  while (g_dump_off < g_dump_len) {
+    int room = Serial.availableForWrite();
+    if (room <= 0) return;
+    size_t n = g_dump_len - g_dump_off;
+    if (n > (size_t)room) n = (size_t)room;
+    n = Serial.write((const uint8_t *)g_dump + g_dump_off, n);
+    if (n == 0) return;
+    g_dump_off += n;
+  }
+  g_dump_len = g_dump_off = 0;
+}
+
+// 调试串口按行读命令，目前只认 "metrics"
+void metrics_service()
+{
+  static char line[16];
+  static uint8_t n = 0;
+
+  dump_drain();
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    if (c < 0) break;
+    if (c == '\r') continue;
+    if (c != '\n') {
+      if (n < sizeof(line) - 1) line[n++] = (char)c;
+      continue;
+    }
+    line[n] = '\0';
+    n = 0;
+    // 上一份还没写完就不重新生成，写完再输命令
+    if (strcmp(line, "metrics") == 0 && g_dump_len == 0) {
+      g_dump_len = metrics_format(g_dump, sizeof(g_dump));
+      g_dump_off = 0;
+      dump_drain();
+    }
+  }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Arduino.h>
+
+/* =========================
+ * 运行指标（长时间展出时盯退化用）
+ *   GET /metrics            纯文本，一行一个 "名字 值"（Prometheus 文本格式）
+ *   调试串口输入 metrics     打印同样内容（按串口发送缓冲的空位分几轮写完，不阻塞 IO 侧）
+ *
+ * 内容：loop 频率 / 窗口内最长一轮 / 开机以来最长一轮，播放动作时的舵机帧间隔，
+ *       各核忙碌占比和日志队列丢弃（见 cores.h），命令总线各来源的发布 / 丢弃 / 未知命令 / 最长延迟（见 bus.h），
+ *       空闲堆 / 开机最低空闲堆 / 最大可分配块，各任务栈剩余高水位，
+ *       sys.cpp 各固定池占用 / 峰值 / 池满次数，ASR I2C 错误，WS2812 推送帧率
+ *
+ * loop 相关计数只在 loop 任务里写，按窗口结算后存进原子变量，
+ * Web 回调（AsyncTCP 任务）读取不用加锁
+ * ========================= */
+#define METRICS_WINDOW_MS   1000
+#define METRICS_TEXT_MAX    4096    // 静态缓冲，不放任务栈上
+
+void metrics_init();
+void metrics_loop_tick();                       // loop() 开头调用，每轮一次
+void metrics_service();                         // IO 侧调用：处理串口 "metrics" 命令，续写没写完的输出
+size_t metrics_format(char *buf, size_t cap);   // 输出文本，返回长度（不含结尾 0）
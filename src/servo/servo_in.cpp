@@ -1,13 +1,14 @@
 #include "servo_in.h"
+#include <stdlib.h>
 
 
-Servo E; 
-Servo Y; 
-Servo Z; 
-Servo R;
-Servo A;
-Servo B;
-Servo C;
+HalServo E; 
+HalServo Y; 
+HalServo Z; 
+HalServo R;
+HalServo A;
+HalServo B;
+HalServo C;
 
 //****************************************//
 struct AxisState {
@@ -93,7 +94,7 @@ int clampOffset(const AxisState &ax, int o){
  * @warning 如果 stepSize 过大可能导致运动不够平滑
  *          如果 stepDelayMs 过小可能导致舵机抖动
  */
-void moveToSmooth_Blocking(Servo &s, AxisState &ax, int targetOffset, int stepDelayMs, int stepSize){
+void moveToSmooth_Blocking(HalServo &s, AxisState &ax, int targetOffset, int stepDelayMs, int stepSize){
   if(stepSize < 1) stepSize = 1;
 
   targetOffset = clampOffset(ax, targetOffset);
@@ -105,7 +106,7 @@ void moveToSmooth_Blocking(Servo &s, AxisState &ax, int targetOffset, int stepDe
     else                      ax.o += (diff > 0 ? stepSize : -stepSize);
 
     s.write(axisAngle(ax));
-    delay(stepDelayMs);
+    hal_delay_ms(stepDelayMs);
   }
 }
 
@@ -118,7 +119,7 @@ void Servo_zero(){
   A.write(axisReset(Aax));
   B.write(axisReset(Bax));
   C.write(axisReset(Cax));
-  delay(500);
+  hal_delay_ms(500);
   R.write(axisReset(Rax));
 }
 
@@ -140,9 +141,9 @@ void Servo_Default(){
   axisReset(Bax);
   axisReset(Cax);
 
-  delay(1000);
+  hal_delay_ms(1000);
   Servo_zero();
-  delay(500);
+  hal_delay_ms(500);
 }
 
 
@@ -155,7 +156,7 @@ void Servo_init(){
   A.attach(A_Pin);
   B.attach(B_Pin);
   C.attach(C_Pin);
-  delay(50);
+  hal_delay_ms(50);
   Servo_Default();
 }
 
@@ -171,8 +172,6 @@ inline void writeRYZ(){
 //*****************动作****************//
 //{  R,   Y,   Z,  time}
 
-enum { AX_R, AX_Y, AX_Z, AX_E, AX_A, AX_B, AX_C, AX_N };
-
 struct Step3 {
   int rOff;        // R 目标偏移
   int yOff;        // Y 目标偏移
@@ -765,6 +764,53 @@ const StepN act_overload_need2_override_urgent_15s[] = {
 
 
 
+// 动作编号表：下标即 SEQ_ID_*，顺序必须与 servo_in.h 的枚举一致
+struct SeqEntry {
+  const StepN* seq;
+  int n;
+};
+
+#define SEQ_ENTRY(x) { (x), SEQ_LEN(x) }
+
+static const SeqEntry seqTable[SEQ_ID_COUNT] = {
+  { nullptr, 0 },                                   // SEQ_ID_NONE
+  SEQ_ENTRY(act_zero),
+  SEQ_ENTRY(act_shakeR),
+  SEQ_ENTRY(act_wave),
+  SEQ_ENTRY(act_demo),
+  SEQ_ENTRY(act_test),
+  SEQ_ENTRY(zhizhidiandian),
+  SEQ_ENTRY(act_nod_ack),
+  SEQ_ENTRY(act_scan_look),
+  SEQ_ENTRY(act_wave_hi),
+  SEQ_ENTRY(act_proud_ok),
+  SEQ_ENTRY(act_confused),
+  SEQ_ENTRY(act_firest),
+  SEQ_ENTRY(act_air_warning),
+  SEQ_ENTRY(act_report_crash),
+  SEQ_ENTRY(act_gas_wave_need_cores_map),
+  SEQ_ENTRY(act_dismantle_god_myth),
+  SEQ_ENTRY(act_blow_the_box_fast),
+  SEQ_ENTRY(act_emergency_oxygen),
+  SEQ_ENTRY(act_ai_party_dizzy),
+  SEQ_ENTRY(act_party_glitch_spasm),
+  SEQ_ENTRY(act_point_3_knobs_20s),
+  SEQ_ENTRY(act_doubt_not_sure_6s),
+  SEQ_ENTRY(act_nav_abandoned_port),
+  SEQ_ENTRY(act_nervous_apology_6s),
+  SEQ_ENTRY(act_accuse_god_15s),
+  SEQ_ENTRY(act_point_power_source_2s),
+  SEQ_ENTRY(act_overload_need2_override_urgent_15s),
+};
+
+static uint8_t seqIdOf(const StepN* seq){
+  for(int i=1;i<SEQ_ID_COUNT;i++){
+    if(seqTable[i].seq == seq) return (uint8_t)i;
+  }
+  return SEQ_ID_NONE;
+}
+
+
 //***********************************//
 //***********************************//
 //***********************************//
@@ -776,6 +822,7 @@ const StepN act_overload_need2_override_urgent_15s[] = {
 
 struct MoveRuntimeN {
   bool running = false;
+  uint8_t id = SEQ_ID_NONE;   // SEQ_ID_*，遥测用
   const StepN* seq = nullptr;
   int n = 0;
   int idx = 0;
@@ -787,6 +834,7 @@ struct MoveRuntimeN {
 
 static MoveRuntimeN player;
 static int16_t outOff[AX_N];   // 本帧输出 offset
+static ServoMotion g_motion = {};   // 最近一次写舵机时的 offset / 速度（灯效联动用）
 
 
 
@@ -821,15 +869,15 @@ struct MoveRuntime3 {
 
 
 struct AxisCfg {
-  Servo*     s;
+  HalServo*  s;
   AxisState* ax;
   int16_t    minOff;   // 安全偏移下限
   int16_t    maxOff;   // 安全偏移上限
 };
 
 int clampOffsetSafe(const AxisState &ax, int o, int minOff, int maxOff){
-  int lo = max(-ax.D, minOff);
-  int hi = min(180 - ax.D, maxOff);
+  int lo = (-ax.D > minOff) ? -ax.D : minOff;
+  int hi = (180 - ax.D < maxOff) ? 180 - ax.D : maxOff;
   return clampi(o, lo, hi);
 }
 
@@ -869,6 +917,14 @@ static void prepareSegment(int idx){
   }
 }
 
+// 记录写舵机后的实际 offset（已夹紧）
+static void motionNote(uint32_t now){
+  g_motion.t_ms = now;
+  for(int i=0;i<AX_N;i++){
+    g_motion.off[i] = (int16_t)axes[i].ax->o;
+  }
+}
+
 void writeAllCurrent(){
   for(int i=0;i<AX_N;i++){
     axes[i].s->write(axisAngle(*axes[i].ax));
@@ -882,7 +938,7 @@ void writeAllCurrent(){
  * @return false  当前没有播放或已播放完成
  *
  * @details
- * 该函数基于 millis() 推进当前动作序列的时间。
+ * 该函数基于 hal_millis() 推进当前动作序列的时间。
  * 每次调用会：
  *   1. 计算当前段的插值进度 u (0~1)
  *   2. 通过缓动函数 easeInOut(u) 得到平滑比例
@@ -907,7 +963,7 @@ bool updateSequence(){
 
   const StepN &st = player.seq[player.idx];
 
-  uint32_t now = millis();
+  uint32_t now = hal_millis();
   uint32_t el  = now - player.segStartMs;
 
   uint16_t dur = st.durMs;
@@ -916,13 +972,18 @@ bool updateSequence(){
 
   float e = easeInOut(u);
 
-  // 1) 插值计算 N 轴 offset
+  // 缓动曲线的导数 6u(1-u)，换算成 度/秒 的比例
+  float de = (dur == 0) ? 0.0f : 6.0f * u * (1.0f - u) * 1000.0f / (float)dur;
+
+  // 1) 插值计算 N 轴 offset，顺便算速度
   for(int i=0;i<AX_N;i++){
     outOff[i] = (int16_t)(player.start[i] + (int)(player.delta[i] * e));
+    g_motion.vel[i] = (int16_t)clampi((int)(player.delta[i] * de), -32767, 32767);
   }
 
   // 2) 安全夹紧 + 写舵机（你已经有 applyOffsets）
   applyOffsets(axes, AX_N, outOff);
+  motionNote(now);
 
   // 3) 段结束 -> 切换下一段
   if(u >= 1.0f){
@@ -960,10 +1021,11 @@ bool updateSequence(){
  */
 void beginSequence(const StepN* seq, int n){
   player.running = true;
+  player.id = seqIdOf(seq);
   player.seq = seq;
   player.n = n;
   player.idx = 0;
-  player.segStartMs = millis();
+  player.segStartMs = hal_millis();
 
   prepareSegment(0);
   updateSequence(); // 立刻输出第一帧
@@ -1025,7 +1087,7 @@ static void playSequence(const StepN* seq, int n, bool interrupt=true){
  *
  * @details
  * 该函数负责驱动当前动作序列的插值计算与舵机输出。
- * 内部基于 millis() 进行非阻塞时间推进。
+ * 内部基于 hal_millis() 进行非阻塞时间推进。
  *
  * 若当前没有动作在播放，则函数内部会立即返回。
  *
@@ -1042,6 +1104,32 @@ void Servo_Update(){
   updateSequence();
 }
 
+/**
+ * @brief  实时设定点输入（外部流式控制用）
+ *
+ * @param  off  AX_N 个轴的目标 offset，顺序同 AX_R..AX_C
+ *
+ * @details
+ * 抢占当前动作序列，直接按 axes[] 的安全范围夹紧后写舵机，
+ * AxisState 同步更新，之后再播放动作会从真实位置起步。
+ */
+void Servo_ApplyLive(const int16_t *off){
+  stopSequence();
+  for(int i=0;i<AX_N;i++){
+    outOff[i] = off[i];
+  }
+  applyOffsets(axes, AX_N, outOff);
+
+  // 实时流没有曲线可求导，用相邻两次设定点差分
+  uint32_t now = hal_millis();
+  uint32_t dt = now - g_motion.t_ms;
+  for(int i=0;i<AX_N;i++){
+    int32_t v = (dt > 0 && dt <= SERVO_MOTION_STALE_MS) ? (int32_t)(axes[i].ax->o - g_motion.off[i]) * 1000 / (int32_t)dt : 0;
+    g_motion.vel[i] = (int16_t)clampi(v, -32767, 32767);
+  }
+  motionNote(now);
+}
+
 /**
  * @brief  强制停止当前动作序列
  *
@@ -1072,6 +1160,91 @@ bool Servo_IsBusy(){
   return isSequenceRunning();
 }
 
+/**
+ * @brief  多轴平滑移动到指定姿态（走播放器，有缓动和安全夹紧）
+ *
+ * @param  off    AX_N 个目标 offset，只看 mask 里置位的轴
+ * @param  mask   bit i 对应 AX_i；没置位的轴保持当前 offset
+ * @param  durMs  插值时间，0 = 下一帧直接到位
+ *
+ * @details
+ * 目标直接写进单段静态序列 poseSeq，不另外拷贝，
+ * 之后和普通动作一样由 Servo_Update() 推进。
+ */
+static StepN poseSeq[1];
+
+void Servo_MoveTo(const int16_t *off, uint8_t mask, uint16_t durMs){
+  stopSequence();
+  for(int i=0;i<AX_N;i++){
+    poseSeq[0].off[i] = (mask & (1 << i)) ? off[i] : (int16_t)axes[i].ax->o;
+  }
+  poseSeq[0].durMs = durMs;
+  beginSequence(poseSeq, 1);
+  player.id = SEQ_ID_POSE;
+}
+
+// 读出各轴当前 offset（AxisState.o），顺序同 AX_R..AX_C
+void Servo_GetOffsets(int16_t *out){
+  for(int i=0;i<AX_N;i++){
+    out[i] = (int16_t)axes[i].ax->o;
+  }
+}
+
+// 运动快照；超过 SERVO_MOTION_STALE_MS 没写过舵机就认为静止
+void Servo_GetMotion(ServoMotion &m){
+  m = g_motion;
+  if(hal_millis() - g_motion.t_ms > SERVO_MOTION_STALE_MS){
+    for(int i=0;i<AX_N;i++) m.vel[i] = 0;
+  }
+}
+
+void Servo_GetPlayerState(ServoPlayerState &st){
+  st.running   = player.running;
+  st.seq_id    = player.running ? player.id : (uint8_t)SEQ_ID_NONE;
+  st.seg_idx   = (uint8_t)player.idx;
+  st.seg_count = (uint8_t)player.n;
+}
+
+/**
+ * @brief  从 LittleFS 加载一套动作并播放（串口 / HTTP 上传的新编排用，show_run 按 /show/<id>.seq 调）
+ *
+ * @param  path  文件路径，例如 "/show/05.seq"
+ * @return true  加载成功并开始播放；false 时当前动作不受影响
+ *
+ * @details
+ * 文件是连续的 SEQ_FILE_RECORD_LEN 字节记录（小端）：
+ *   int16 off[AX_N]（顺序 R Y Z E A B C） + uint16 durMs
+ * 最多 SEQ_FILE_MAX_STEPS 段，多出的忽略；一段都没有（空文件 / 不足一条记录）算失败。
+ * 两块静态缓冲轮流用：先读进播放器没在用的那块，校验通过才停掉当前动作切过去，
+ * 文件不存在或是空的都不会打断正在播的动作。
+ */
+static StepN fileSeq[2][SEQ_FILE_MAX_STEPS];
+static uint8_t fileSeqCur = 0;   // 播放器可能正指向的那块
+
+bool Servo_PlayFile(const char *path){
+  HalFile f = hal_fs_open(path);
+  if(f < 0) return false;
+
+  StepN *dst = fileSeq[fileSeqCur ^ 1];
+  uint8_t rec[SEQ_FILE_RECORD_LEN];
+  int n = 0;
+  while(n < SEQ_FILE_MAX_STEPS && hal_fs_read(f, rec, sizeof(rec)) == sizeof(rec)){
+    for(int i=0;i<AX_N;i++){
+      dst[n].off[i] = (int16_t)(rec[2*i] | (rec[2*i+1] << 8));
+    }
+    dst[n].durMs = (uint16_t)(rec[2*AX_N] | (rec[2*AX_N+1] << 8));
+    n++;
+  }
+  hal_fs_close(f);
+  if(n == 0) return false;
+
+  stopSequence();
+  fileSeqCur ^= 1;
+  beginSequence(dst, n);
+  player.id = SEQ_ID_FILE;
+  return true;
+}
+
 /**
  * @brief  动作触发时间防抖变量
  *
@@ -1089,7 +1262,7 @@ static uint32_t lastTrigMs = 0;
  * @return false  触发间隔过短，被抑制
  *
  * @details
- * 通过 millis() 计算两次触发的时间差。
+ * 通过 hal_millis() 计算两次触发的时间差。
  * 若间隔小于 300ms，则认为是重复触发，不执行。
  *
  * 适用于语音识别、按键抖动、串口重复数据等场景。
@@ -1098,7 +1271,7 @@ static uint32_t lastTrigMs = 0;
  * 如需调整灵敏度，可修改 300ms 阈值。
  */
 static bool canTrigger(){
-  uint32_t now = millis();
+  uint32_t now = hal_millis();
   if(now - lastTrigMs < 300) return false; // 300ms 防抖
   lastTrigMs = now;
   return true;
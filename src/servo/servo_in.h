@@ -1,7 +1,6 @@
 #pragma once
 
-#include <Arduino.h>
-#include <Servo.h>
+#include "../hal/hal.h"
 
 #define A_Pin 36
 #define B_Pin 37
@@ -23,9 +22,68 @@
 
 
 
+// 轴顺序（动作表 KF 的列顺序）
+enum { AX_R, AX_Y, AX_Z, AX_E, AX_A, AX_B, AX_C, AX_N };
+
 #define KF(r,y,z,e,a,b,c,ms)  { { (r),(y),(z),(e),(a),(b),(c) }, (uint16_t)(ms) }
 #define SEQ_LEN(x) (int)(sizeof(x)/sizeof((x)[0]))
 
+// 动作编号（遥测 / Web 用），与 servo_in.cpp 里的 seqTable 一一对应
+enum {
+  SEQ_ID_NONE = 0,
+  SEQ_ID_ZERO,
+  SEQ_ID_SHAKE_R,
+  SEQ_ID_WAVE,
+  SEQ_ID_DEMO,
+  SEQ_ID_TEST,
+  SEQ_ID_ZHIZHIDIANDIAN,
+  SEQ_ID_NOD_ACK,
+  SEQ_ID_SCAN_LOOK,
+  SEQ_ID_WAVE_HI,
+  SEQ_ID_PROUD_OK,
+  SEQ_ID_CONFUSED,
+  SEQ_ID_FIREST,
+  SEQ_ID_AIR_WARNING,
+  SEQ_ID_REPORT_CRASH,
+  SEQ_ID_GAS_WAVE_NEED_CORES_MAP,
+  SEQ_ID_DISMANTLE_GOD_MYTH,
+  SEQ_ID_BLOW_THE_BOX_FAST,
+  SEQ_ID_EMERGENCY_OXYGEN,
+  SEQ_ID_AI_PARTY_DIZZY,
+  SEQ_ID_PARTY_GLITCH_SPASM,
+  SEQ_ID_POINT_3_KNOBS_20S,
+  SEQ_ID_DOUBT_NOT_SURE_6S,
+  SEQ_ID_NAV_ABANDONED_PORT,
+  SEQ_ID_NERVOUS_APOLOGY_6S,
+  SEQ_ID_ACCUSE_GOD_15S,
+  SEQ_ID_POINT_POWER_SOURCE_2S,
+  SEQ_ID_OVERLOAD_NEED2_OVERRIDE_URGENT_15S,
+  SEQ_ID_COUNT,
+
+  SEQ_ID_POSE = 0xFD,   // Servo_MoveTo 的单段姿态
+  SEQ_ID_FILE = 0xFE,   // 从 LittleFS 加载的动作
+};
+
+// 播放器状态快照
+struct ServoPlayerState {
+  bool    running;
+  uint8_t seq_id;       // SEQ_ID_*
+  uint8_t seg_idx;      // 当前段
+  uint8_t seg_count;    // 总段数
+};
+
+// 运动快照（灯效联动用）：播放器 / 实时流写舵机时顺手记下，不另外计算
+#define SERVO_MOTION_STALE_MS 100
+struct ServoMotion {
+  uint32_t t_ms;        // 最近一次写舵机的时间
+  int16_t  off[AX_N];   // 实际 offset（已夹紧）
+  int16_t  vel[AX_N];   // 度/秒，播放器用缓动曲线导数，实时流用差分
+};
+
+// LittleFS 动作文件：每段 7×int16 offset + uint16 毫秒，小端
+#define SEQ_FILE_MAX_STEPS   64
+#define SEQ_FILE_RECORD_LEN  (2 * AX_N + 2)
+
 
 void Servo_init();
 
@@ -35,6 +93,12 @@ void Servo_Update();
 // 控制
 void Servo_Stop();
 bool Servo_IsBusy();
+void Servo_ApplyLive(const int16_t *off);   // 实时设定点（抢占动作）
+bool Servo_PlayFile(const char *path);      // 播放 LittleFS 里的动作文件
+void Servo_MoveTo(const int16_t *off, uint8_t mask, uint16_t durMs);   // 多轴姿态插值
+void Servo_GetOffsets(int16_t *out);        // 各轴当前 offset
+void Servo_GetPlayerState(ServoPlayerState &st);
+void Servo_GetMotion(ServoMotion &m);       // 各轴 offset + 速度
 
 // 动作触发（外部只调用这些）
 void Servo_PlayZero();
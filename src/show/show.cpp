@@ -0,0 +1,75 @@
+#include "show.h"
+#include "../servo/servo_in.h"
+#include "../ws2812/ws2812.h"
+#include "../ws2812/ws2812_motion.h"
+#include "../sys/sys.h"
+#include "../sys/bus.h"
+#include "../config/config.h"   // 引脚宏，放在 sys.h 后面（sys.h 的形参同名）
+
+#include <stdio.h>
+
+namespace {
+
+#define SHOW_PATH_MAX  16
+
+// 第 i 行就是编号 i，空号填 nullptr；加演出 = 加一行
+struct ShowRow {
+  uint8_t key;
+  void (*servo)();
+  void (*fx)();
+  bool motion;     // 演出期间灯效亮度 / 速率跟着动作走（ws2812_motion.h）
+};
+
+// 要传引脚的灯效包一层，表里统一是 void()
+static void fx_first()     { biz_pulse_led(Leaser_pin_1,Leaser_pin_2,Leaser_pin_3); ws2812_demo1(); }
+static void fx_gas_wave()  { biz_start_gas_wave_scan(Leaser_pin_1,Leaser_pin_2,Leaser_pin_3); }
+static void fx_blow_box()  { biz_start_blow_box(Leaser_pin_1,Leaser_pin_2,Leaser_pin_3); }
+static void fx_knobs()     { biz_start_point_knobs(Leaser_pin_1,Leaser_pin_2,Leaser_pin_3); }
+static void fx_apology()   { biz_start_nervous_apology(Radar_pin); }
+
+static constexpr ShowRow k_shows[] = {
+  { 0x00, nullptr,                                       nullptr,                      false },
+  { 0x01, Servo_act_firest,                              fx_first,                     false },
+  { 0x02, Servo_PlayZero,                                nullptr,                      false },
+  { 0x03, Servo_PlayDemo,                                nullptr,                      false },
+  { 0x04, Servo_act_test1,                               nullptr,                      false },
+  { 0x05, Servo_act_air_warning,                         biz_start_air_warning,        false }, // 空气预警
+  { 0x06, Servo_act_report_crash,                        biz_start_crash_report,       false }, // 坠毁报告
+  { 0x07, Servo_act_gas_wave_need_cores_map,             fx_gas_wave,                  false }, // 气体波形扫描
+  { 0x08, Servo_act_dismantle_god_myth,                  biz_start_dismantle_myth,     false }, // 拆解谜团
+  { 0x09, Servo_act_blow_the_box_fast,                   fx_blow_box,                  false }, // 直接炸箱子
+  { 0x0A, nullptr,                                       nullptr,                      false },
+  { 0x0B, Servo_act_emergency_oxygen,                    biz_start_emergency_oxygen,   false }, // 应急制氧
+  { 0x0C, Servo_act_ai_party_dizzy,                      biz_start_ai_party_dizzy,     true  }, // 派对/眩晕
+  { 0x0D, Servo_act_party_glitch_spasm,                  biz_start_glitch_spasm,       true  }, // 抽风乱甩（含彩虹灯效）
+  { 0x0E, Servo_act_point_3_knobs_20s,                   fx_knobs,                     false }, // 旋钮分析提示
+  { 0x0F, Servo_act_doubt_not_sure_6s,                   biz_start_doubt,              false }, // 怀疑状态
+  { 0x10, Servo_act_nav_abandoned_port,                  biz_start_nav_port,           false }, // 导航废弃港口
+  { 0x11, Servo_act_nervous_apology_6s,                  fx_apology,                   false }, // 紧张道歉
+  { 0x12, Servo_act_accuse_god_15s,                      biz_start_accusation,         false }, // 指责情绪
+  { 0x13, Servo_act_point_power_source_2s,               biz_start_point_power,        false }, // 电力装置指向
+  { 0x14, Servo_act_overload_need2_override_urgent_15s,  biz_start_overload_override,  false }, // 装置超载覆写
+};
+static_assert(bus_table_dense(k_shows), "k_shows row i must have key i");
+
+} // namespace
+
+bool show_exists(uint8_t id)
+{
+  const ShowRow *row = bus_table_row(k_shows, id);
+  return row && row->servo;
+}
+
+bool show_run(uint8_t id)
+{
+  if (!show_exists(id)) return false;
+  const ShowRow &row = k_shows[id];
+  // 上传过 /show/<id>.seq 就用文件里的动作顶替内置的，灯效照旧；不用重新烧固件就能改编排
+  char path[SHOW_PATH_MAX];
+  snprintf(path, sizeof(path), "/show/%02x.seq", id);
+  if (!Servo_PlayFile(path)) row.servo();
+  if (row.fx) row.fx();
+  ws2812_motion_enable(row.motion);
+  hal_log("%u\n", id);
+  return true;
+}
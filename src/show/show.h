@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../hal/hal.h"
+
+/* =========================
+ * 演出表：语音词条编号 -> 舵机动作 + 灯效/激光任务
+ * 语音 / 串口 / Web 都用同一套编号：命令经事件总线（bus.h）到实时侧后调 show_run，
+ * Web 在入队前用 show_exists 挡掉没有演出的编号（回 404）
+ * 0x0A 和 0x14 以后没有演出
+ * 舵机动作可以用上传的文件顶替：LittleFS 里有 /show/<id>.seq（两位小写十六进制，如 /show/05.seq，
+ * 格式见 Servo_PlayFile）就播文件，没有或读不出来就播内置动作
+ * ========================= */
+
+bool show_exists(uint8_t id);
+bool show_run(uint8_t id);       // 只在实时侧（loopTask）调用；没有这个演出返回 false
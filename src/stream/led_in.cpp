@@ -0,0 +1,47 @@
+#include "led_in.h"
+#include "../ws2812/ws2812.h"
+#ifndef HAL_NATIVE
+#include <AsyncUDP.h>
+#endif
+
+static_assert(LED_COUNT <= LED_RX_MAX_LEDS, "LED_COUNT exceeds live ingest buffer");
+
+namespace {
+
+static void on_led_chunk(const uint8_t *p, uint8_t len)
+{
+  if (len < LINK_LED_HDR || (len - LINK_LED_HDR) % 3 != 0) { led_rx_bad_packet(); return; }
+  led_rx_chunk(p[0], link_get_u16(&p[1]), &p[LINK_LED_HDR], (uint16_t)((len - LINK_LED_HDR) / 3),
+               (p[3] & LINK_LED_FLAG_END) != 0, hal_millis());
+}
+
+} // namespace
+
+void led_in_init()
+{
+  led_rx_init(LED_COUNT);
+  uartInOnPacket(LINK_TYPE_LED_FRAME, on_led_chunk);
+}
+
+#ifndef HAL_NATIVE
+// UDP 只在板子上有（主机上用 tools/led_send listen 测拼帧）
+static AsyncUDP g_artnet;
+static AsyncUDP g_e131;
+
+void led_in_udp_begin()
+{
+  // 回调在 AsyncUDP 任务里：只解析、写槽位，不做别的；轮询 / 同步这类包直接忽略
+  if (g_artnet.listen(LED_PROTO_ARTNET_PORT)) {
+    g_artnet.onPacket([](AsyncUDPPacket &pkt) {
+      LedDmx d;
+      if (led_proto_parse_artnet(pkt.data(), pkt.length(), d)) led_rx_dmx(d, hal_millis());
+    });
+  }
+  if (g_e131.listen(LED_PROTO_E131_PORT)) {
+    g_e131.onPacket([](AsyncUDPPacket &pkt) {
+      LedDmx d;
+      if (led_proto_parse_e131(pkt.data(), pkt.length(), d)) led_rx_dmx(d, hal_millis());
+    });
+  }
+}
+#endif // HAL_NATIVE
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../hal/hal.h"
+#include "led_rx.h"
+#include "../uart/uart_in.h"
+
+/* =========================
+ * 外部灯光台实时接管灯带
+ *
+ * 两路输入，进同一个抖动缓冲（拼帧 / 回放策略见 led_rx.h）：
+ *   UDP    Art-Net（6454）和 E1.31（5568，单播），在 AsyncUDP 任务里直接写槽位
+ *   串口   LINK_TYPE_LED_FRAME 分块包（格式见 link_frame.h），在 loop 里处理
+ * 会话进行中 ws2812 不再跑分区渲染和片段，直接把槽位推出去（仍过电流限制）；
+ * LED_RX_TIMEOUT_MS 收不到包就交还。数据按原值输出，gamma 由灯光台负责。
+ *
+ * 本机回环测试：tools/led_send
+ * ========================= */
+
+void led_in_init();         // 串口分块包处理；setup 里调用
+void led_in_udp_begin();    // WiFi 起来以后调用，开始监听 UDP
@@ -0,0 +1,115 @@
+#pragma once
+
+/* =========================
+ * 灯光台 -> 灯带 的网络帧格式（与主机共用，不依赖 Arduino）
+ *
+ * 只认数据包，其它（轮询、发现、同步）忽略：
+ *   Art-Net ArtDmx    UDP 6454，"Art-Net\0" + OpCode 0x5000，数据从第 18 字节开始
+ *   E1.31 (sACN)      UDP 5568，根层 / 帧层 / DMP 层，数据从第 126 字节开始（起始码 0）
+ * 一个 universe 放 170 颗灯（510 通道，RGB 顺序），universe 号从各自的 base 起连续排。
+ * ========================= */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define LED_PROTO_ARTNET_PORT   6454
+#define LED_PROTO_E131_PORT     5568
+#define LED_PROTO_ARTNET_BASE   0       // Art-Net 从 universe 0 开始
+#define LED_PROTO_E131_BASE     1       // E1.31 从 universe 1 开始
+#define LED_PROTO_LEDS_PER_UNI  170
+#define LED_PROTO_DMX_MAX       512
+
+#define LED_PROTO_ARTNET_HDR    18
+#define LED_PROTO_E131_HDR      126
+
+// 解析结果：data 指向收到的包内部，不拷贝
+struct LedDmx {
+  uint16_t universe;      // 已减掉 base（0 = 第一段灯）
+  uint8_t  seq;           // 0 = 发送端不编号
+  const uint8_t *data;    // RGB RGB ...
+  uint16_t len;           // 通道数
+};
+
+static inline uint16_t led_proto_be16(const uint8_t *p) { return (uint16_t)((p[0] << 8) | p[1]); }
+
+static inline bool led_proto_parse_artnet(const uint8_t *p, size_t n, LedDmx &out)
+{
+  if (n < LED_PROTO_ARTNET_HDR || memcmp(p, "Art-Net", 8) != 0) return false;
+  if (p[8] != 0x00 || p[9] != 0x50) return false;               // 只要 ArtDmx
+  uint16_t len = led_proto_be16(&p[16]);
+  if (len > LED_PROTO_DMX_MAX || LED_PROTO_ARTNET_HDR + (size_t)len > n) return false;
+  uint16_t uni = (uint16_t)(p[14] | ((p[15] & 0x7F) << 8));
+#if LED_PROTO_ARTNET_BASE > 0
+  if (uni < LED_PROTO_ARTNET_BASE) return false;
+#endif
+  out.universe = (uint16_t)(uni - LED_PROTO_ARTNET_BASE);
+  out.seq = p[12];
+  out.data = &p[LED_PROTO_ARTNET_HDR];
+  out.len = len;
+  return true;
+}
+
+static inline bool led_proto_parse_e131(const uint8_t *p, size_t n, LedDmx &out)
+{
+  static const uint8_t k_acn_id[12] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+  if (n < LED_PROTO_E131_HDR || memcmp(&p[4], k_acn_id, 12) != 0) return false;
+  if (p[21] != 0x04 || p[43] != 0x02 || p[117] != 0x02) return false;   // 数据包
+  if (p[112] & 0x40) return false;                                     // Stream_Terminated
+  uint16_t count = led_proto_be16(&p[123]);                            // 含起始码
+  if (count < 1 || count - 1 > LED_PROTO_DMX_MAX || LED_PROTO_E131_HDR + (size_t)count - 1 > n) return false;
+  if (p[125] != 0) return false;                                       // 只要 DMX 起始码 0
+  uint16_t uni = led_proto_be16(&p[113]);
+#if LED_PROTO_E131_BASE > 0
+  if (uni < LED_PROTO_E131_BASE) return false;
+#endif
+  out.universe = (uint16_t)(uni - LED_PROTO_E131_BASE);
+  out.seq = p[111];
+  out.data = &p[LED_PROTO_E131_HDR];
+  out.len = (uint16_t)(count - 1);
+  return true;
+}
+
+// 组包（主机端发送 / 回环测试用），返回包长
+static inline size_t led_proto_build_artnet(uint8_t *out, uint16_t universe, uint8_t seq,
+                                            const uint8_t *rgb, uint16_t len)
+{
+  universe = (uint16_t)(universe + LED_PROTO_ARTNET_BASE);
+  memcpy(out, "Art-Net", 8);
+  out[8] = 0x00; out[9] = 0x50;           // OpDmx
+  out[10] = 0; out[11] = 14;              // 协议版本
+  out[12] = seq;
+  out[13] = 0;
+  out[14] = (uint8_t)universe;
+  out[15] = (uint8_t)(universe >> 8);
+  out[16] = (uint8_t)(len >> 8);
+  out[17] = (uint8_t)len;
+  memcpy(&out[LED_PROTO_ARTNET_HDR], rgb, len);
+  return LED_PROTO_ARTNET_HDR + (size_t)len;
+}
+
+static inline size_t led_proto_build_e131(uint8_t *out, uint16_t universe, uint8_t seq,
+                                          const uint8_t *rgb, uint16_t len)
+{
+  universe = (uint16_t)(universe + LED_PROTO_E131_BASE);
+  memset(out, 0, LED_PROTO_E131_HDR);
+  auto fl = [&](size_t at, size_t end) {  // flags(0x7) + PDU 长度
+    uint16_t v = (uint16_t)(0x7000 | ((end - at) & 0x0FFF));
+    out[at] = (uint8_t)(v >> 8); out[at + 1] = (uint8_t)v;
+  };
+  size_t total = LED_PROTO_E131_HDR + len;
+  out[1] = 0x10;                                            // preamble
+  memcpy(&out[4], "ASC-E1.17", 9);
+  fl(16, total);  out[21] = 0x04;                           // 根层
+  fl(38, total);  out[43] = 0x02;                           // 帧层
+  memcpy(&out[44], "led_send", 8);
+  out[108] = 100;                                           // 优先级
+  out[111] = seq;
+  out[113] = (uint8_t)(universe >> 8); out[114] = (uint8_t)universe;
+  fl(115, total); out[117] = 0x02; out[118] = 0xA1;         // DMP 层
+  out[122] = 1;                                             // 地址增量
+  out[123] = (uint8_t)((len + 1) >> 8); out[124] = (uint8_t)(len + 1);
+  out[125] = 0;                                             // 起始码
+  memcpy(&out[LED_PROTO_E131_HDR], rgb, len);
+  return total;
+}
@@ -0,0 +1,228 @@
+#include "led_rx.h"
+
+#include <atomic>
+#include <string.h>
+
+namespace {
+
+static_assert((LED_RX_SLOTS & (LED_RX_SLOTS - 1)) == 0, "slot count must be power of 2");
+static_assert(LED_RX_MAX_UNIVERSES <= 32, "universe mask is 32 bits");
+
+alignas(4) static uint8_t g_slots[LED_RX_SLOTS][LED_RX_MAX_LEDS * 3];
+static std::atomic<uint8_t>  g_head{0};          // 只由生产者写
+static std::atomic<uint8_t>  g_tail{0};          // 只由消费者写
+static uint32_t              g_slot_ms[LED_RX_SLOTS];   // 发布时间
+static std::atomic<uint32_t> g_last_rx_ms{0};
+static std::atomic<bool>     g_seen{false};              // 收到过包
+static std::atomic<uint16_t> g_period_ms{LED_RX_MAX_PERIOD_MS};
+static std::atomic_flag      g_prod_lock = ATOMIC_FLAG_INIT;
+
+static uint16_t g_leds = 0;
+static uint8_t  g_unis = 0;
+static LedRxStats g_stats = {};
+
+// 生产者：正在拼的帧
+static bool     g_asm_open = false;
+static bool     g_asm_drop = false;      // 缓冲满，这一帧拼完直接丢
+static uint32_t g_asm_mask = 0;
+static uint8_t  g_asm_seq = 0;
+static uint8_t  g_uni_seq[LED_RX_MAX_UNIVERSES];
+static uint32_t g_last_pub_ms = 0;
+static bool     g_has_pub = false;
+
+// 消费者：回放时钟
+static bool     g_playing = false;
+static uint32_t g_next_ms = 0;
+
+static inline uint8_t *asm_slot()
+{
+  return g_slots[g_head.load(std::memory_order_relaxed) & (LED_RX_SLOTS - 1)];
+}
+
+static void asm_open(uint8_t seq)
+{
+  uint8_t h = g_head.load(std::memory_order_relaxed);
+  g_asm_open = true;
+  g_asm_mask = 0;
+  g_asm_seq = seq;
+  g_asm_drop = (uint8_t)(h - g_tail.load(std::memory_order_acquire)) >= LED_RX_SLOTS;
+  if (!g_asm_drop) memset(asm_slot(), 0, (size_t)g_leds * 3);
+}
+
+static void asm_publish(uint32_t now_ms)
+{
+  g_asm_open = false;
+  if (g_asm_drop) { g_stats.overflow_drops++; return; }
+
+  // 帧间隔估计：1/8 权重滑动平均
+  if (g_has_pub) {
+    uint32_t dt = now_ms - g_last_pub_ms;
+    if (dt < LED_RX_MIN_PERIOD_MS) dt = LED_RX_MIN_PERIOD_MS;
+    if (dt > LED_RX_MAX_PERIOD_MS) dt = LED_RX_MAX_PERIOD_MS;
+    uint16_t p = g_period_ms.load(std::memory_order_relaxed);
+    g_period_ms.store((uint16_t)((p * 7 + dt + 4) / 8), std::memory_order_relaxed);
+  }
+  g_has_pub = true;
+  g_last_pub_ms = now_ms;
+
+  g_slot_ms[g_head.load(std::memory_order_relaxed) & (LED_RX_SLOTS - 1)] = now_ms;
+  g_head.store((uint8_t)(g_head.load(std::memory_order_relaxed) + 1), std::memory_order_release);
+  g_stats.frames++;
+}
+
+// RGB -> GRB 直接写进槽位
+static inline void put_rgb(uint8_t *slot, uint16_t first, const uint8_t *rgb, uint16_t n)
+{
+  uint8_t *d = &slot[first * 3];
+  for (uint16_t i = 0; i < n; i++, d += 3, rgb += 3) {
+    d[0] = rgb[1];
+    d[1] = rgb[0];
+    d[2] = rgb[2];
+  }
+}
+
+struct ProdLock {
+  bool ok;
+  ProdLock() : ok(!g_prod_lock.test_and_set(std::memory_order_acquire)) { if (!ok) g_stats.contended++; }
+  ~ProdLock() { if (ok) g_prod_lock.clear(std::memory_order_release); }
+};
+
+} // namespace
+
+void led_rx_init(uint16_t leds)
+{
+  if (leds > LED_RX_MAX_LEDS) leds = LED_RX_MAX_LEDS;
+  g_leds = leds;
+  g_unis = (uint8_t)((leds + LED_PROTO_LEDS_PER_UNI - 1) / LED_PROTO_LEDS_PER_UNI);
+}
+
+void led_rx_dmx(const LedDmx &d, uint32_t now_ms)
+{
+  ProdLock lk;
+  if (!lk.ok) return;
+  if (d.universe >= g_unis) { g_stats.bad_packets++; return; }
+
+  // E1.31 的规则：比上一包旧 20 以内算乱序 / 重复，更旧的当作发送端重启
+  uint8_t &last = g_uni_seq[d.universe];
+  int8_t diff = (int8_t)(d.seq - last);
+  if (d.seq != 0 && last != 0 && diff <= 0 && diff > -20) { g_stats.late_drops++; return; }
+  last = d.seq;
+
+  g_stats.packets++;
+  g_last_rx_ms.store(now_ms, std::memory_order_release);
+  g_seen.store(true, std::memory_order_release);
+
+  uint32_t bit = 1u << d.universe;
+  if (g_asm_open && (g_asm_mask & bit)) {    // 同一 universe 又来了：上一帧没拼完
+    g_stats.incomplete++;
+    g_asm_open = false;
+  }
+  if (!g_asm_open) asm_open(d.seq);
+
+  uint16_t first = (uint16_t)(d.universe * LED_PROTO_LEDS_PER_UNI);
+  uint16_t n = d.len / 3;
+  if (n > LED_PROTO_LEDS_PER_UNI) n = LED_PROTO_LEDS_PER_UNI;
+  if (first + n > g_leds) n = (uint16_t)(g_leds - first);
+  if (!g_asm_drop) put_rgb(asm_slot(), first, d.data, n);
+
+  g_asm_mask |= bit;
+  if (g_asm_mask == (g_unis >= 32 ? 0xFFFFFFFFu : (1u << g_unis) - 1)) asm_publish(now_ms);
+}
+
+void led_rx_chunk(uint8_t seq, uint16_t first, const uint8_t *rgb, uint16_t n, bool end, uint32_t now_ms)
+{
+  ProdLock lk;
+  if (!lk.ok) return;
+  if ((uint32_t)first + n > g_leds) { g_stats.bad_packets++; return; }
+
+  g_stats.packets++;
+  g_last_rx_ms.store(now_ms, std::memory_order_release);
+  g_seen.store(true, std::memory_order_release);
+
+  if (g_asm_open && seq != g_asm_seq) {       // 换帧了，上一帧没收到结束块
+    g_stats.incomplete++;
+    g_asm_open = false;
+  }
+  if (!g_asm_open) asm_open(seq);
+  if (!g_asm_drop) put_rgb(asm_slot(), first, rgb, n);
+  if (end) asm_publish(now_ms);
+}
+
+void led_rx_bad_packet()
+{
+  g_stats.bad_packets++;
+}
+
+bool led_rx_active(uint32_t now_ms)
+{
+  if (!g_seen.load(std::memory_order_acquire)) return false;
+  bool live = (uint32_t)(now_ms - g_last_rx_ms.load(std::memory_order_acquire)) < LED_RX_TIMEOUT_MS;
+
+  if (live && !g_stats.active) {
+    g_stats.active = true;
+    g_stats.sessions++;
+    g_playing = false;
+  } else if (!live && g_stats.active) {
+    g_stats.active = false;
+    g_tail.store(g_head.load(std::memory_order_acquire), std::memory_order_release);   // 剩下的不放了
+    g_stats.depth = 0;
+  }
+  return live;
+}
+
+const uint8_t *led_rx_peek(uint32_t now_ms)
+{
+  if (!g_stats.active) return nullptr;
+
+  uint8_t t = g_tail.load(std::memory_order_relaxed);
+  uint8_t depth = (uint8_t)(g_head.load(std::memory_order_acquire) - t);
+  uint16_t period = g_period_ms.load(std::memory_order_relaxed);
+  g_stats.period_ms = period;
+
+  if (depth == 0) {
+    if (g_playing && (int32_t)(now_ms - g_next_ms) > (int32_t)(period / 2)) {   // 超时半个帧间隔还没来
+      g_stats.underruns++;
+      g_playing = false;        // 重新预缓冲
+    }
+    g_stats.depth = 0;
+    return nullptr;
+  }
+
+  // 预缓冲：攒够再开始；只有一帧的（静态画面）等够一个最长帧间隔也放
+  if (!g_playing) {
+    uint32_t waited = now_ms - g_slot_ms[t & (LED_RX_SLOTS - 1)];
+    if (depth < LED_RX_PREBUFFER && waited < LED_RX_MAX_PERIOD_MS) {
+      g_stats.depth = depth;
+      return nullptr;
+    }
+    g_playing = true;
+    g_next_ms = now_ms;
+  }
+
+  // 攒多了丢最旧的，延迟不超过 LED_RX_TARGET_DEPTH 帧
+  while (depth > LED_RX_TARGET_DEPTH) {
+    t++;
+    depth--;
+    g_stats.skipped++;
+  }
+  g_tail.store(t, std::memory_order_release);
+  g_stats.depth = depth;
+
+  if ((int32_t)(now_ms - g_next_ms) < 0) return nullptr;
+  return g_slots[t & (LED_RX_SLOTS - 1)];
+}
+
+void led_rx_consume(uint32_t now_ms)
+{
+  g_tail.store((uint8_t)(g_tail.load(std::memory_order_relaxed) + 1), std::memory_order_release);
+  g_stats.played++;
+
+  uint16_t period = g_period_ms.load(std::memory_order_relaxed);
+  g_next_ms += period;
+  if ((int32_t)(now_ms - g_next_ms) > (int32_t)period) g_next_ms = now_ms + period;   // 落后太多，重新对齐
+}
+
+const LedRxStats &led_rx_stats()
+{
+  return g_stats;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+/* =========================
+ * 外部灯光帧接收：拼帧 + 抖动缓冲（不依赖 Arduino，主机回环测试直接链接这份）
+ *
+ * 生产者（UDP 回调任务 / loop 里的串口包处理）把每个 universe 或分块从收包缓冲直接写进空闲槽位
+ * （RGB 换成 GRB，第一次拷贝），拼齐一帧才发布；消费者拿到槽位指针交给 ws_out_show()，
+ * 那里按功率限制缩放写进 RMT 发送缓冲（第二次拷贝）。第二次省不掉：RMT 是异步读的，
+ * 槽位在 led_rx_consume() 之后马上还给生产者。中间没有别的缓冲。
+ * 单生产者 / 单消费者：两路同时进来时后到的那包丢掉计 contended。
+ *
+ * 回放：新会话先攒 LED_RX_PREBUFFER 帧再开始，之后按估计的帧间隔匀速出帧；
+ * 缓冲里超过 LED_RX_TARGET_DEPTH 帧就丢最旧的，把延迟压住；
+ * 到点没帧可放记一次欠载，重新预缓冲。
+ * ========================= */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "led_proto.h"
+
+#define LED_RX_MAX_LEDS        512
+#define LED_RX_SLOTS           4       // 必须是 2 的幂
+#define LED_RX_PREBUFFER       2
+#define LED_RX_TARGET_DEPTH    2
+#define LED_RX_TIMEOUT_MS      1000    // 这么久没收到包，结束会话、交还给分区渲染
+#define LED_RX_MIN_PERIOD_MS   5
+#define LED_RX_MAX_PERIOD_MS   100
+#define LED_RX_MAX_UNIVERSES   ((LED_RX_MAX_LEDS + LED_PROTO_LEDS_PER_UNI - 1) / LED_PROTO_LEDS_PER_UNI)
+
+struct LedRxStats {
+  // 生产者写
+  uint32_t packets;          // 收下的包（universe / 分块）
+  uint32_t bad_packets;      // 格式不认识、universe 或灯号超范围
+  uint32_t late_drops;       // 序号比同一 universe 上一包旧（乱序 / 重复）
+  uint32_t frames;           // 拼完整、发布的帧
+  uint32_t incomplete;       // 没拼完就开始了下一帧，丢掉的半帧
+  uint32_t overflow_drops;   // 缓冲满，整帧丢掉
+  uint32_t contended;        // 两路同时写，丢掉的包
+  // 消费者写
+  uint32_t played;           // 推出去的帧
+  uint32_t skipped;          // 为了压延迟丢掉的旧帧
+  uint32_t underruns;        // 到点没帧
+  uint32_t sessions;
+  uint16_t period_ms;        // 估计的帧间隔
+  uint8_t  depth;            // 当前缓冲帧数
+  bool     active;
+};
+
+void led_rx_init(uint16_t leds);
+
+// 生产者
+void led_rx_dmx(const LedDmx &d, uint32_t now_ms);
+void led_rx_chunk(uint8_t seq, uint16_t first, const uint8_t *rgb, uint16_t n, bool end, uint32_t now_ms);
+void led_rx_bad_packet();
+
+// 消费者（loop）
+bool led_rx_active(uint32_t now_ms);            // 会话进行中：输出归外部
+const uint8_t *led_rx_peek(uint32_t now_ms);    // 该出的帧（GRB，led 数 × 3），没有返回 nullptr
+void led_rx_consume(uint32_t now_ms);           // peek 到的帧推出去了，槽位还给生产者
+
+const LedRxStats &led_rx_stats();
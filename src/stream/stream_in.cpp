@@ -0,0 +1,155 @@
+#include "stream_in.h"
+
+static_assert(LINK_SETPOINT_AXES == AX_N, "setpoint packet axis count must match servo axes");
+
+namespace {
+
+struct StreamSlot {
+  bool     used = false;
+  uint16_t seq = 0;
+  uint32_t due_ms = 0;           // 本地回放时刻
+  int16_t  off[AX_N];
+};
+
+static StreamSlot g_slots[STREAM_SLOTS];
+static StreamStats g_stats = {};
+
+static int32_t  g_anchor = 0;    // 本地时间 - 主机时间 + 回放延迟
+static uint16_t g_last_seq = 0;  // 最后播放的序号
+static uint32_t g_last_rx_ms = 0;
+static uint32_t g_last_play_ms = 0;
+static bool     g_underrun = false;
+
+// 回绕比较：a 是否在 b 之后
+static inline bool seq_after(uint16_t a, uint16_t b) { return (int16_t)(a - b) > 0; }
+
+static void stream_reset()
+{
+  for (auto &s : g_slots) s.used = false;
+  g_stats.depth = 0;
+  g_stats.active = false;
+}
+
+static void on_setpoint(const uint8_t *p, uint8_t len)
+{
+  if (len < LINK_SETPOINT_LEN) return;
+
+  uint32_t now  = hal_millis();
+  uint16_t seq  = link_get_u16(p);
+  uint32_t t_ms = link_get_u32(p + 2);
+  g_stats.rx++;
+
+  // 新会话：用第一包对齐时钟
+  if (!g_stats.active || (now - g_last_rx_ms) > STREAM_TIMEOUT_MS) {
+    stream_reset();
+    g_anchor = (int32_t)(now - t_ms) + STREAM_PLAYOUT_DELAY_MS;
+    g_last_seq = seq - 1;
+    g_last_play_ms = now;
+    g_underrun = false;
+    g_stats.active = true;
+    g_stats.sessions++;
+  }
+  g_last_rx_ms = now;
+
+  if (!seq_after(seq, g_last_seq)) { g_stats.late_drops++; return; }
+
+  uint32_t due = t_ms + g_anchor;
+
+  // 主机时钟比本地快、包越来越“早”：把锚点往回拉，避免延迟越积越大
+  int32_t early = (int32_t)(due - now);
+  if (early > 2 * STREAM_PLAYOUT_DELAY_MS) {
+    g_anchor -= early - STREAM_PLAYOUT_DELAY_MS;
+    due = t_ms + g_anchor;
+  }
+
+  StreamSlot *slot = nullptr;
+  StreamSlot *oldest = nullptr;
+  for (auto &s : g_slots) {
+    if (s.used && s.seq == seq) { g_stats.late_drops++; return; }   // 重复
+    if (!s.used) { if (!slot) slot = &s; continue; }
+    if (!oldest || seq_after(oldest->seq, s.seq)) oldest = &s;
+  }
+  if (!slot) {
+    slot = oldest;
+    g_stats.overflow_drops++;
+    g_stats.depth--;
+  }
+
+  slot->used = true;
+  slot->seq = seq;
+  slot->due_ms = due;
+  for (int i = 0; i < AX_N; i++) {
+    slot->off[i] = (int16_t)link_get_u16(p + 6 + 2 * i);
+  }
+  g_stats.depth++;
+}
+
+} // namespace
+
+void stream_in_init()
+{
+  stream_reset();
+  uartInOnPacketRt(LINK_TYPE_SETPOINT, on_setpoint);   // 和 stream_in_service 共用状态，放实时侧
+}
+
+/**
+ * @brief  抖动缓冲回放（必须在 loop() 中持续调用）
+ *
+ * @details
+ * 到期的帧里只放序号最新的一帧，更旧的直接丢掉（计 skipped），
+ * 没有帧可放时保持最后姿态，超过 STREAM_UNDERRUN_MS 记一次欠载，
+ * 超过 STREAM_TIMEOUT_MS 没收到包则结束本次流，舵机停在原地交还给播放器。
+ */
+void stream_in_service()
+{
+  if (!g_stats.active) return;
+
+  uint32_t now = hal_millis();
+  if ((now - g_last_rx_ms) > STREAM_TIMEOUT_MS) {
+    stream_reset();
+    return;
+  }
+
+  StreamSlot *pick = nullptr;
+  for (auto &s : g_slots) {
+    if (!s.used || (int32_t)(now - s.due_ms) < 0) continue;
+    if (pick && seq_after(pick->seq, s.seq)) {
+      s.used = false;
+      g_stats.depth--;
+      g_stats.skipped++;
+      continue;
+    }
+    if (pick) {
+      pick->used = false;
+      g_stats.depth--;
+      g_stats.skipped++;
+    }
+    pick = &s;
+  }
+
+  if (!pick) {
+    if (!g_underrun && (now - g_last_play_ms) > STREAM_UNDERRUN_MS) {
+      g_underrun = true;
+      g_stats.underruns++;
+    }
+    return;
+  }
+
+  Servo_ApplyLive(pick->off);
+  g_last_seq = pick->seq;
+  g_last_play_ms = now;
+  g_underrun = false;
+  pick->used = false;
+  g_stats.depth--;
+  g_stats.played++;
+}
+
+bool stream_in_active()
+{
+  return g_stats.active;
+}
+
+const StreamStats &stream_in_stats()
+{
+  return g_stats;
+}
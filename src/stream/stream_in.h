@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../hal/hal.h"
+#include "../uart/uart_in.h"
+#include "../servo/servo_in.h"
+
+/* =========================
+ * 实时设定点流（现场操控）
+ * 主机以 100Hz+ 发 LINK_TYPE_SETPOINT 包（格式见 link_frame.h），
+ * 设备端用小抖动缓冲按主机时间戳 + 固定延迟回放给舵机
+ * ========================= */
+#define STREAM_SLOTS             8     // 抖动缓冲槽位
+#define STREAM_PLAYOUT_DELAY_MS  30    // 回放延迟（吸收抖动）
+#define STREAM_UNDERRUN_MS       25    // 超过这么久没有新帧可放，记一次欠载（保持最后姿态）
+#define STREAM_TIMEOUT_MS        300   // 超过这么久没收到包，结束本次流
+
+struct StreamStats {
+  uint32_t rx;              // 收到的设定点包
+  uint32_t played;          // 实际写到舵机的帧
+  uint32_t late_drops;      // 序号比已播放的旧 / 重复
+  uint32_t skipped;         // 同一次回放里被更新帧覆盖的旧帧
+  uint32_t overflow_drops;  // 缓冲满挤掉的帧
+  uint32_t underruns;       // 欠载次数
+  uint32_t sessions;        // 开始过几次流
+  uint8_t  depth;           // 当前缓冲深度
+  bool     active;
+};
+
+void stream_in_init();
+void stream_in_service();
+bool stream_in_active();
+const StreamStats &stream_in_stats();
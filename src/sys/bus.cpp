@@ -0,0 +1,68 @@
+#include "bus.h"
+#include "spsc.h"
+
+namespace {
+
+static SpscQueue<BusEvent, BUS_QUEUE> g_lanes[BUS_SRC_COUNT];
+static BusSourceStats g_stats[BUS_SRC_COUNT];
+
+static const char *const k_source_names[BUS_SRC_COUNT] = { "asr", "uart", "web" };
+
+} // namespace
+
+BusEvent *bus_reserve(BusSource src)
+{
+  if (src >= BUS_SRC_COUNT) return nullptr;
+  BusEvent *ev = g_lanes[src].reserve();
+  if (!ev) g_stats[src].dropped++;
+  return ev;
+}
+
+void bus_commit(BusSource src)
+{
+  BusEvent *ev = g_lanes[src].reserve();   // 就是刚才 bus_reserve 给出的那一格
+  ev->t_ms = hal_millis();
+  ev->src = src;
+  g_lanes[src].commit();
+  g_stats[src].published++;
+}
+
+bool bus_publish(BusSource src, BusKind kind, uint8_t id)
+{
+  BusEvent *ev = bus_reserve(src);
+  if (!ev) return false;
+  ev->kind = kind;
+  ev->id = id;
+  ev->mask = 0;
+  ev->dur_ms = 0;
+  bus_commit(src);
+  return true;
+}
+
+void bus_service(const BusRoute *routes, uint8_t n)
+{
+  for (uint8_t s = 0; s < BUS_SRC_COUNT; s++) {
+    SpscQueue<BusEvent, BUS_QUEUE> &lane = g_lanes[s];
+    BusSourceStats &st = g_stats[s];
+    const BusEvent *ev;
+    while ((ev = lane.front()) != nullptr) {
+      uint32_t lat = hal_millis() - ev->t_ms;
+      if (lat > st.lat_max_ms) st.lat_max_ms = lat;
+
+      BusHandler fn = ev->kind < n ? routes[ev->kind].fn : nullptr;
+      if (fn && fn(*ev)) st.dispatched++;
+      else               st.unknown++;
+      lane.release();
+    }
+  }
+}
+
+const BusSourceStats &bus_stats(BusSource src)
+{
+  return g_stats[src < BUS_SRC_COUNT ? src : 0];
+}
+
+const char *bus_source_name(BusSource src)
+{
+  return src < BUS_SRC_COUNT ? k_source_names[src] : "?";
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../hal/hal.h"
+#include "../servo/servo_in.h"
+
+/* =========================
+ * 命令事件总线
+ *
+ * 所有命令源（语音模块、命令串口、Web）都发布成带时间戳的 BusEvent，
+ * 由实时侧 loop 里的 bus_service() 按表分发，执行只在 loopTask 里发生。
+ *
+ * 每个来源一条 SPSC 队列（spsc.h），来源和生产者任务一一对应：
+ *   BUS_SRC_ASR / BUS_SRC_UART   IO 任务（cores.h；不拆核时是 loopTask）
+ *   BUS_SRC_WEB                  AsyncTCP 任务
+ * 队满丢弃并计数，不阻塞生产者。
+ *
+ * 分发表按下标直接查（O(1)）：表的第 i 行必须是 key == i，空号填 nullptr，
+ * 用 bus_table_dense() 在编译期检查。加命令 = 在表里加一行。
+ * ========================= */
+#define BUS_QUEUE  8        // 每个来源的队列深度（2 的幂）
+
+enum BusSource : uint8_t {
+  BUS_SRC_ASR,
+  BUS_SRC_UART,
+  BUS_SRC_WEB,
+  BUS_SRC_COUNT,
+};
+
+enum BusKind : uint8_t {
+  BUS_EV_SHOW,      // 演出：id = 语音词条编号
+  BUS_EV_POSE,      // 多轴姿态插值：mask / off / dur_ms，同 Servo_MoveTo
+  BUS_EV_STOP,      // 停止当前动作
+  BUS_EV_COUNT,
+};
+
+struct BusEvent {
+  uint32_t t_ms;        // 发布时刻（bus_commit 填）
+  uint8_t  src;         // BusSource（bus_commit 填）
+  uint8_t  kind;        // BusKind
+  uint8_t  id;          // SHOW
+  uint8_t  mask;        // POSE
+  uint16_t dur_ms;      // POSE
+  int16_t  off[AX_N];   // POSE
+};
+
+// 返回 false = 表里没有这个命令（计入 unknown）
+typedef bool (*BusHandler)(const BusEvent &ev);
+
+struct BusRoute {
+  uint8_t    key;
+  BusHandler fn;
+};
+
+// 每个来源一份，只增不减（lat_max_ms 除外）
+struct BusSourceStats {
+  uint32_t published;     // 进了队列的
+  uint32_t dropped;       // 队满丢掉的
+  uint32_t dispatched;    // 找到处理函数并执行的
+  uint32_t unknown;       // 分发表里没有的
+  uint32_t lat_max_ms;    // 发布到执行的最长延迟
+};
+
+// 生产者：reserve 拿空位就地填写（kind 及对应字段），commit 发布；队满返回 nullptr
+BusEvent *bus_reserve(BusSource src);
+void      bus_commit(BusSource src);
+bool      bus_publish(BusSource src, BusKind kind, uint8_t id);   // 只带 id 的事件
+
+// 实时侧 loop 里调用：按来源顺序取空各队列，按 kind 查 routes 分发
+void bus_service(const BusRoute *routes, uint8_t n);
+
+template <size_t N>
+inline void bus_service(const BusRoute (&routes)[N])
+{
+  bus_service(routes, (uint8_t)N);
+}
+
+const BusSourceStats &bus_stats(BusSource src);
+const char *bus_source_name(BusSource src);
+
+// 编译期检查：第 i 行的 key 就是 i（任何带 key 成员的行类型都行）
+template <typename Row, size_t N>
+constexpr bool bus_table_dense(const Row (&t)[N], size_t i = 0)
+{
+  return i >= N ? true : (t[i].key == i && bus_table_dense(t, i + 1));
+}
+
+// 按下标查表，越界 / 空号返回 nullptr
+template <typename Row, size_t N>
+inline const Row *bus_table_row(const Row (&t)[N], uint8_t key)
+{
+  return key < N ? &t[key] : nullptr;
+}
@@ -0,0 +1,151 @@
+#include "cores.h"
+#include "spsc.h"
+
+#ifndef HAL_NATIVE
+#include <Arduino.h>
+#define CORES_LOG_RING 1
+#else
+#define CORES_LOG_RING 0
+#endif
+#define CORES_TASKS (CORE_SPLIT && CORES_LOG_RING)
+
+// 主机上的拆核（真线程、真时钟）只给 tools/core_bench 对比舵机帧间隔用，编译时加 -DCORES_NATIVE_THREAD；
+// 平时主机构建和 show_sim 一样在 loop 开头直接调 io_step，虚拟时钟下结果可重复
+#if defined(HAL_NATIVE) && defined(CORES_NATIVE_THREAD) && CORE_SPLIT
+#define CORES_THREAD 1
+#include <chrono>
+#include <thread>
+#else
+#define CORES_THREAD 0
+#endif
+
+namespace {
+
+struct LogLine {
+  char text[CORE_LOG_LINE];
+};
+
+static SpscQueue<LogLine, CORE_LOG_QUEUE> g_logs;
+static CoreStats  g_stats = {};
+static CoreIoStep g_io_step = nullptr;
+
+// 忙碌时间：每个核只由自己那边的任务写
+struct BusyWindow {
+  uint32_t start_us;
+  uint32_t busy_us;
+};
+static BusyWindow g_win[2];
+static uint32_t   g_rt_t0 = 0;
+
+static void busy_note(uint8_t core, uint32_t t0, uint32_t t1)
+{
+  BusyWindow &w = g_win[core];
+  w.busy_us += t1 - t0;
+  uint32_t el = t1 - w.start_us;
+  if (el < (uint32_t)CORE_WINDOW_MS * 1000) return;
+  uint32_t pct = (uint32_t)((uint64_t)w.busy_us * 100 / el);
+  g_stats.busy_pct[core] = (uint8_t)(pct > 100 ? 100 : pct);
+  w.start_us = t1;
+  w.busy_us = 0;
+}
+
+#if CORES_LOG_RING
+static TaskHandle_t g_rt_task = nullptr;
+
+// 只有 loopTask 的日志排队（单生产者）；别的任务照常直接打印
+static bool log_sink(const char *text)
+{
+  if (xTaskGetCurrentTaskHandle() != g_rt_task) return false;
+  LogLine *l = g_logs.reserve();
+  if (!l) { g_stats.log_drops++; return true; }
+  strncpy(l->text, text, sizeof(l->text) - 1);
+  l->text[sizeof(l->text) - 1] = '\0';
+  g_logs.commit();
+  return true;
+}
+
+// 不阻塞：发送缓冲放不下整行就留到下一轮，积压满了在 log_sink 那边计丢弃
+static void log_drain()
+{
+  const LogLine *l;
+  while ((l = g_logs.front()) != nullptr) {
+    size_t n = strlen(l->text);
+    if ((size_t)Serial.availableForWrite() < n) break;
+    Serial.write((const uint8_t *)l->text, n);
+    g_logs.release();
+    g_stats.log_lines++;
+  }
+}
+#endif
+
+#if CORES_TASKS
+static void io_task(void *)
+{
+  g_win[CORE_IO].start_us = hal_micros();
+  for (;;) {
+    uint32_t t0 = hal_micros();
+    g_io_step();
+    log_drain();
+    busy_note(CORE_IO, t0, hal_micros());
+    vTaskDelay(1);
+  }
+}
+#endif
+
+#if CORES_THREAD
+// 和 io_task 一样：跑一轮让出 1 tick（1ms）
+static void io_thread()
+{
+  g_win[CORE_IO].start_us = hal_micros();
+  for (;;) {
+    uint32_t t0 = hal_micros();
+    g_io_step();
+    busy_note(CORE_IO, t0, hal_micros());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+#endif
+
+} // namespace
+
+void cores_start_io(CoreIoStep io_step)
+{
+  g_io_step = io_step;
+  g_win[CORE_RT].start_us = g_win[CORE_IO].start_us = hal_micros();
+#if CORES_LOG_RING
+  g_rt_task = xTaskGetCurrentTaskHandle();
+  hal_log_sink(log_sink);
+#endif
+#if CORES_TASKS
+  if (xTaskCreatePinnedToCore(io_task, "io_task", CORE_IO_STACK, nullptr, CORE_IO_PRIO, nullptr, CORE_IO) == pdPASS) {
+    g_stats.split = true;
+    return;
+  }
+  hal_log("cores: io task create failed, running single-core\n");
+#endif
+#if CORES_THREAD
+  std::thread(io_thread).detach();
+  g_stats.split = true;
+#endif
+}
+
+void cores_rt_begin()
+{
+  g_rt_t0 = hal_micros();
+  if (g_stats.split) return;
+  if (g_io_step) g_io_step();
+#if CORES_LOG_RING
+  log_drain();
+#endif
+}
+
+void cores_rt_end()
+{
+  // 不让出：1 号核上没有别的本固件任务要跑（io_task 钉在 0 号核），每圈睡 1 tick 只会把舵机帧间隔拉到 1ms 以上
+  busy_note(CORE_RT, g_rt_t0, hal_micros());
+}
+
+const CoreStats &cores_stats()
+{
+  return g_stats;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../hal/hal.h"
+
+/* =========================
+ * 双核分工
+ *
+ *   1 号核（实时）  Arduino loopTask：舵机插值、灯带渲染 / 推送、sys 任务（激光时序）、
+ *                   实时流回放、执行语音 / 串口 / Web 命令（bus_service）
+ *   0 号核（IO）    cores_start_io() 建的任务：ASR 轮询、命令串口解析、调试串口命令、
+ *                   Web 遥测广播 / 客户端清理、打印实时侧的日志；WiFi / AsyncTCP 本来就在这边
+ *
+ * 两边只经过 SPSC 队列（spsc.h）交换：
+ *   命令    IO → 实时   事件总线（bus.h），每个来源一条队列
+ *   数据包  IO → 实时   uartInOnPacketRt 注册的类型（uart_in.cpp 里的队列）
+ *   遥测    实时 → IO   web_service 抄的状态快照，web_io_service 组帧广播（web.cpp）
+ *   日志    实时 → IO   loopTask 里的 hal_log 排队，IO 任务打印；调试串口发送缓冲
+ *                       放不下就留到下一轮，loopTask 从不等串口
+ * IO 任务每轮让出 1 tick；loopTask 不让出（1 号核上没有别的本固件任务），一直转，
+ * 所以 1 号核的忙碌占比接近 100%，看舵机帧间隔用 /metrics 的 servo_gap_*。
+ * 各核上本固件任务的忙碌占比按窗口结算（不含 WiFi 协议栈）。
+ *
+ * CORE_SPLIT 0 或主机构建：不建任务，io_step 在 loop 开头直接调用，
+ * 和拆核前一样都在 loopTask 里跑，方便对比舵机帧间隔（/metrics 的 servo_gap_*）。
+ * 主机上要对比拆核用 tools/core_bench（加 -DCORES_NATIVE_THREAD，io_step 放到单独线程）。
+ * 日志队列在 ESP32 上总是开着（CORE_SPLIT 0 时在 loop 开头打印），主机构建直接输出。
+ * ========================= */
+#ifndef CORE_SPLIT
+#define CORE_SPLIT        1
+#endif
+#define CORE_RT           1        // loopTask 默认所在的核
+#define CORE_IO           0
+#define CORE_IO_STACK     6144
+#define CORE_IO_PRIO      1        // 和 loopTask 一样
+#define CORE_LOG_QUEUE    16
+#define CORE_LOG_LINE     128      // 更长的日志截断
+#define CORE_WINDOW_MS    1000
+
+struct CoreStats {
+  uint8_t  busy_pct[2];    // 上个窗口里本固件任务在 0 / 1 号核上的忙碌占比
+  bool     split;          // IO 任务是否真的跑在另一个核上
+  uint32_t log_lines;      // 实时侧经队列打印的行数
+  uint32_t log_drops;      // 日志队列满丢掉的行
+};
+
+typedef void (*CoreIoStep)();
+
+void cores_start_io(CoreIoStep io_step);   // setup 最后调用（在 loopTask 里）
+void cores_rt_begin();                     // loop() 开头
+void cores_rt_end();                       // loop() 结尾：计忙碌时间（不让出）
+
+const CoreStats &cores_stats();
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/* =========================
+ * 单生产者 / 单消费者有界队列（无锁）
+ *
+ * 两个核之间传东西只用这个：生产者只写 head，消费者只写 tail，
+ * 元素先写好再 release 发布下标，另一边 acquire 读下标后再读元素。
+ * 满了 push 返回 false，由调用方计丢弃，不覆盖、不阻塞。
+ * N 必须是 2 的幂；下标用 uint16_t 自由回绕，N 最大 32768。
+ * ========================= */
+template <typename T, uint16_t N>
+class SpscQueue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "queue size must be power of 2");
+  static_assert(N <= 32768, "queue size must fit uint16_t wrap");
+
+public:
+  // 生产者：拿到空位写好后 commit；满了返回 nullptr
+  T *reserve() {
+    uint16_t h = head_.load(std::memory_order_relaxed);
+    if ((uint16_t)(h - tail_.load(std::memory_order_acquire)) >= N) return nullptr;
+    return &buf_[h & (N - 1)];
+  }
+  void commit() {
+    head_.store((uint16_t)(head_.load(std::memory_order_relaxed) + 1), std::memory_order_release);
+  }
+  bool push(const T &v) {
+    T *slot = reserve();
+    if (!slot) return false;
+    *slot = v;
+    commit();
+    return true;
+  }
+
+  // 消费者：front 看队头，用完 release；空了返回 nullptr
+  const T *front() const {
+    uint16_t t = tail_.load(std::memory_order_relaxed);
+    if (t == head_.load(std::memory_order_acquire)) return nullptr;
+    return &buf_[t & (N - 1)];
+  }
+  void release() {
+    tail_.store((uint16_t)(tail_.load(std::memory_order_relaxed) + 1), std::memory_order_release);
+  }
+  bool pop(T &out) {
+    const T *p = front();
+    if (!p) return false;
+    out = *p;
+    release();
+    return true;
+  }
+
+  uint16_t depth() const {
+    return (uint16_t)(head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire));
+  }
+
+private:
+  T buf_[N];
+  std::atomic<uint16_t> head_{0};   // 只由生产者写
+  std::atomic<uint16_t> tail_{0};   // 只由消费者写
+};
@@ -8,7 +8,9 @@
 
 namespace {
 
-
+// 池占用统计：投递成功后记峰值，池满记失败（定义在所有池之后）
+static void pool_note_alloc(uint8_t pool);
+static void pool_note_full(uint8_t pool);
 
 
 static constexpr uint8_t MAX_IO_LEVEL_TASKS = 16;
@@ -17,7 +19,7 @@ struct IoLevelTask {
   bool used = false;
   bool active = false;
   uint8_t pin = 0;
-  uint8_t level = HIGH;        // HIGH / LOW
+  uint8_t level = HAL_HIGH;    // HAL_HIGH / HAL_LOW
   uint32_t trigger_time = 0;
 };
 
@@ -25,7 +27,7 @@ static IoLevelTask g_io_level_tasks[MAX_IO_LEVEL_TASKS];
 
 static bool io_set_level_at(uint8_t pin, uint8_t level, uint32_t delay_ms)
 {
-  uint32_t now = millis();
+  uint32_t now = hal_millis();
   for (int i = 0; i < MAX_IO_LEVEL_TASKS; i++) {
     if (!g_io_level_tasks[i].used || !g_io_level_tasks[i].active) {
       auto &t = g_io_level_tasks[i];
@@ -34,9 +36,11 @@ static bool io_set_level_at(uint8_t pin, uint8_t level, uint32_t delay_ms)
       t.pin = pin;
       t.level = level;
       t.trigger_time = now + delay_ms;
+      pool_note_alloc(SYS_POOL_IO_LEVEL);
       return true;
     }
   }
+  pool_note_full(SYS_POOL_IO_LEVEL);
   return false;
 }
 
@@ -51,7 +55,7 @@ static void sys_iolevel_service(uint32_t now)
 
     if ((int32_t)(now - t.trigger_time) >= 0) {
       t.active = false;
-      digitalWrite(t.pin, t.level);
+      hal_gpio_write(t.pin, t.level);
     }
   }
 }
@@ -65,6 +69,7 @@ static constexpr uint8_t MAX_RUNNING_JOBS = 6;
 
 struct JobRuntime {
   bool active = false;
+  uint8_t id = 0;
   const SysStep* steps = nullptr;
   uint16_t count = 0;
   uint16_t cursor = 0;       // 下一个要执行的 step 下标
@@ -79,13 +84,16 @@ int sys_job_start(const SysJob& job)
   for (int i = 0; i < MAX_RUNNING_JOBS; i++) {
     if (!g_jobs[i].active) {
       g_jobs[i].active   = true;
+      g_jobs[i].id       = job.id;
       g_jobs[i].steps    = job.steps;
       g_jobs[i].count    = job.count;
       g_jobs[i].cursor   = 0;
-      g_jobs[i].start_ms = millis();
+      g_jobs[i].start_ms = hal_millis();
+      pool_note_alloc(SYS_POOL_JOBS);
       return i;
     }
   }
+  pool_note_full(SYS_POOL_JOBS);
   return -1;
 }
 
@@ -119,10 +127,12 @@ static void sys_delay_call(void (*func)(), uint32_t delay_ms)
             g_delay_tasks[i].used = true;
             g_delay_tasks[i].active = true;
             g_delay_tasks[i].callback = func;
-            g_delay_tasks[i].trigger_time = millis() + delay_ms;
+            g_delay_tasks[i].trigger_time = hal_millis() + delay_ms;
+            pool_note_alloc(SYS_POOL_DELAY);
             return;
         }
     }
+    pool_note_full(SYS_POOL_DELAY);
 }
 
 
@@ -138,7 +148,7 @@ struct IoFlipTask {
   bool     active = false;
   uint8_t  pin = 0;
 
-  // 频率翻转：一个“翻转”就是一次电平切换（HIGH<->LOW）
+  // 频率翻转：一个“翻转”就是一次电平切换（HAL_HIGH<->HAL_LOW）
   // times: 翻转次数（例如 10 次 = 切换 10 次）
   uint16_t remaining_toggles = 0;
 
@@ -153,8 +163,8 @@ IoFlipTask g_tasks[MAX_IO_TASKS];
 
 // 立即翻转电平（非阻塞）
 static inline void io_trigger(uint8_t pin) {
-  // ESP32 Arduino：digitalRead 对 OUTPUT 引脚可读回当前电平（通常OK）
-  digitalWrite(pin, !digitalRead(pin));
+  // hal_gpio_read 对输出脚读回当前电平
+  hal_gpio_write(pin, !hal_gpio_read(pin));
 }
 
 // 投递一个“持续翻转任务”
@@ -167,7 +177,7 @@ static bool io_Continuous_flipping(uint8_t pin, float frequency_hz, uint16_t tim
   uint32_t half_period = (uint32_t)(1000.0f / (2.0f * frequency_hz));
   if (half_period == 0) half_period = 1;
 
-  uint32_t now = millis();
+  uint32_t now = hal_millis();
 
   for (uint8_t i = 0; i < MAX_IO_TASKS; i++) {
     if (!g_tasks[i].active) {
@@ -183,9 +193,11 @@ static bool io_Continuous_flipping(uint8_t pin, float frequency_hz, uint16_t tim
       // “下一次到期”从启动点开始（到点就立刻翻转一次）
       t.next_due_ms = t.start_time_ms;
 
+      pool_note_alloc(SYS_POOL_IO_FLIP);
       return true;
     }
   }
+  pool_note_full(SYS_POOL_IO_FLIP);
   return false;
 }
 
@@ -200,6 +212,7 @@ static void sys_delay_service(uint32_t now) {
         if((int32_t)(now - t.trigger_time) >= 0)
         {
             t.active = false;
+            t.used = false;     // 执行完归还槽位（原来一直占着，8 次之后就再也投不进去）
             if(t.callback) t.callback();
         }
     } 
@@ -246,6 +259,7 @@ static void sys_job_service(uint32_t now) {
       if ((int32_t)(now - due) < 0) break; // 还没到
 
       if (st.func) st.func();
+      if (st.clip) ws2812_clip_play(st.clip);
       jr.cursor++;
     }
 
@@ -261,15 +275,15 @@ static inline bool laser_valid(uint8_t pin) { return pin != 0; }
 
 static inline void laser_init_pin(uint8_t pin) {
   if(!laser_valid(pin)) return;
-  pinMode(pin, OUTPUT);
-  digitalWrite(pin, LOW); // 默认关（HIGH=开）
+  hal_gpio_output(pin);
+  hal_gpio_write(pin, HAL_LOW); // 默认关（HAL_HIGH=开）
 }
 
 // 立即开/关
-static inline void laser_on(uint8_t pin)  { if(laser_valid(pin)) digitalWrite(pin, HIGH); }
-static inline void laser_off(uint8_t pin) { if(laser_valid(pin)) digitalWrite(pin, LOW); }
+static inline void laser_on(uint8_t pin)  { if(laser_valid(pin)) hal_gpio_write(pin, HAL_HIGH); }
+static inline void laser_off(uint8_t pin) { if(laser_valid(pin)) hal_gpio_write(pin, HAL_LOW); }
 
-// t1~t2 保持开（HIGH），非阻塞
+// t1~t2 保持开（HAL_HIGH），非阻塞
 static inline void laser_on_between(uint8_t pin, uint32_t t1_ms, uint32_t t2_ms) {
   if(!laser_valid(pin)) return;
   if ((int32_t)(t2_ms - t1_ms) < 0) return;
@@ -277,8 +291,8 @@ static inline void laser_on_between(uint8_t pin, uint32_t t1_ms, uint32_t t2_ms)
   // 如果你有 ioflip 对同 pin 控制，强烈建议先 cancel（如果你已实现 io_flip_cancel）
   // io_flip_cancel(pin);
 
-  io_set_level_at(pin, HIGH, t1_ms);
-  io_set_level_at(pin, LOW,  t2_ms);
+  io_set_level_at(pin, HAL_HIGH, t1_ms);
+  io_set_level_at(pin, HAL_LOW,  t2_ms);
 }
 
 // 脉冲：从 start 开始，持续 on_ms，然后关
@@ -286,6 +300,34 @@ static inline void laser_pulse(uint8_t pin, uint32_t start_ms, uint32_t on_ms) {
   laser_on_between(pin, start_ms, start_ms + on_ms);
 }
 
+// ===== 池占用统计 =====
+static uint8_t  g_pool_peak[SYS_POOL_COUNT];
+static uint32_t g_pool_full[SYS_POOL_COUNT];
+
+static uint8_t pool_used(uint8_t pool)
+{
+  uint8_t n = 0;
+  switch (pool) {
+    case SYS_POOL_IO_LEVEL: for (auto &t : g_io_level_tasks) n += (t.used && t.active); break;
+    case SYS_POOL_JOBS:     for (auto &j : g_jobs)           n += j.active;              break;
+    case SYS_POOL_DELAY:    for (auto &t : g_delay_tasks)    n += (t.used && t.active);  break;
+    case SYS_POOL_IO_FLIP:  for (auto &t : g_tasks)          n += t.active;              break;
+    default: break;
+  }
+  return n;
+}
+
+static void pool_note_alloc(uint8_t pool)
+{
+  uint8_t n = pool_used(pool);
+  if (n > g_pool_peak[pool]) g_pool_peak[pool] = n;
+}
+
+static void pool_note_full(uint8_t pool)
+{
+  g_pool_full[pool]++;
+}
+
 } // namespace
 
 
@@ -296,14 +338,44 @@ static inline void laser_pulse(uint8_t pin, uint32_t start_ms, uint32_t on_ms) {
 void sys_init() {
   // 这里放所有系统初始化：IO、串口、传感器、网络……
   // IO 示例：你也可以不在这里统一 pinMode，而在业务函数里设置
-  // pinMode(2, OUTPUT);
+  // hal_gpio_output(2);
 
   // 清空任务
   for (auto &t : g_tasks) t = IoFlipTask{};
 }
 
+int sys_job_snapshot(SysJobInfo *out, int max)
+{
+  uint32_t now = hal_millis();
+  int n = 0;
+  for (int i = 0; i < MAX_RUNNING_JOBS && n < max; i++) {
+    const auto &jr = g_jobs[i];
+    if (!jr.active) continue;
+    out[n].slot       = (uint8_t)i;
+    out[n].id         = jr.id;
+    out[n].cursor     = jr.cursor;
+    out[n].count      = jr.count;
+    out[n].elapsed_ms = now - jr.start_ms;
+    n++;
+  }
+  return n;
+}
+
+void sys_pool_stats(SysPoolInfo *out)
+{
+  static const char *const names[SYS_POOL_COUNT] = { "io_level", "jobs", "delay", "io_flip" };
+  static const uint8_t caps[SYS_POOL_COUNT] = { MAX_IO_LEVEL_TASKS, MAX_RUNNING_JOBS, MAX_DELAY_TASKS, MAX_IO_TASKS };
+  for (uint8_t i = 0; i < SYS_POOL_COUNT; i++) {
+    out[i].name = names[i];
+    out[i].used = pool_used(i);
+    out[i].cap  = caps[i];
+    out[i].peak = g_pool_peak[i];
+    out[i].full = g_pool_full[i];
+  }
+}
+
 void sys_service() {
-  uint32_t now = millis();
+  uint32_t now = hal_millis();
   sys_delay_service(now);
   sys_iolevel_service(now); 
   sys_ioflip_service(now);
@@ -339,7 +411,7 @@ static const SysStep JOB_0x05_AIR_WARNING_STEPS[] = {
   { ws2812_all_breath_yellow,  5200  },  // 降级：回到警戒黄
   { ws2812_staute_green,       8000  },  // 结束：回绿
 };
-static const SysJob JOB_0x05_AIR_WARNING = { JOB_0x05_AIR_WARNING_STEPS, JOB_COUNT(JOB_0x05_AIR_WARNING_STEPS) };
+static const SysJob JOB_0x05_AIR_WARNING = { JOB_0x05_AIR_WARNING_STEPS, JOB_COUNT(JOB_0x05_AIR_WARNING_STEPS), 0x05 };
 
 void biz_start_air_warning()
 {
@@ -362,7 +434,7 @@ static const SysStep JOB_0x06_CRASH_REPORT_STEPS[] = {
   { ws2812_all_blink_yellow, 4200 }, // “系统抖动/临界”
   { ws2812_staute_red,    6500  },   // 维持红常亮（持续紧张）
 };
-static const SysJob JOB_0x06_CRASH_REPORT = { JOB_0x06_CRASH_REPORT_STEPS, JOB_COUNT(JOB_0x06_CRASH_REPORT_STEPS) };
+static const SysJob JOB_0x06_CRASH_REPORT = { JOB_0x06_CRASH_REPORT_STEPS, JOB_COUNT(JOB_0x06_CRASH_REPORT_STEPS), 0x06 };
 
 void biz_start_crash_report()
 {
@@ -405,7 +477,7 @@ static const SysStep JOB_0x07_GAS_WAVE_SCAN_STEPS[] = {
   { fx_detect_done,           10000 }, // 10s：分析完成/回绿
   { ws2812_staute_green,      11000 },
 };
-static const SysJob JOB_0x07_GAS_WAVE_SCAN = { JOB_0x07_GAS_WAVE_SCAN_STEPS, JOB_COUNT(JOB_0x07_GAS_WAVE_SCAN_STEPS) };
+static const SysJob JOB_0x07_GAS_WAVE_SCAN = { JOB_0x07_GAS_WAVE_SCAN_STEPS, JOB_COUNT(JOB_0x07_GAS_WAVE_SCAN_STEPS), 0x07 };
 void biz_start_gas_wave_scan(uint8_t Leaser_pin_1, uint8_t Leaser_pin_2, uint8_t Leaser_pin_3)
 {
   laeser_gas_wave_scan_scan(Leaser_pin_1, Leaser_pin_2, Leaser_pin_3);
@@ -425,7 +497,7 @@ static const SysStep JOB_0x08_DISMANTLE_MYTH_STEPS[] = {
   { ws2812_all_breath_yellow, 2500  },
   { ws2812_staute_green,      5000  }, // 结论稳定
 };
-static const SysJob JOB_0x08_DISMANTLE_MYTH = { JOB_0x08_DISMANTLE_MYTH_STEPS, JOB_COUNT(JOB_0x08_DISMANTLE_MYTH_STEPS) };
+static const SysJob JOB_0x08_DISMANTLE_MYTH = { JOB_0x08_DISMANTLE_MYTH_STEPS, JOB_COUNT(JOB_0x08_DISMANTLE_MYTH_STEPS), 0x08 };
 void biz_start_dismantle_myth()
 {
   sys_job_start(JOB_0x08_DISMANTLE_MYTH);
@@ -457,7 +529,7 @@ static const SysStep JOB_0x09_BLOW_BOX_STEPS[] = {
   { ws2812_staute_red,      3800  }, // 余震
   { ws2812_staute_green,    6500  }, // 回常态
 };
-static const SysJob JOB_0x09_BLOW_BOX = { JOB_0x09_BLOW_BOX_STEPS, JOB_COUNT(JOB_0x09_BLOW_BOX_STEPS) };
+static const SysJob JOB_0x09_BLOW_BOX = { JOB_0x09_BLOW_BOX_STEPS, JOB_COUNT(JOB_0x09_BLOW_BOX_STEPS), 0x09 };
 void biz_start_blow_box(uint8_t Leaser_pin_1, uint8_t Leaser_pin_2, uint8_t Leaser_pin_3)
 {
   laeser_blow_box_aim(Leaser_pin_1, Leaser_pin_2, Leaser_pin_3);
@@ -480,7 +552,7 @@ static const SysStep JOB_0x0B_EMERGENCY_OXYGEN_STEPS[] = {
   { fx_override_done,          9500  },  // 稳定
   { ws2812_staute_green,       10500 },
 };
-static const SysJob JOB_0x0B_EMERGENCY_OXYGEN = { JOB_0x0B_EMERGENCY_OXYGEN_STEPS, JOB_COUNT(JOB_0x0B_EMERGENCY_OXYGEN_STEPS) };
+static const SysJob JOB_0x0B_EMERGENCY_OXYGEN = { JOB_0x0B_EMERGENCY_OXYGEN_STEPS, JOB_COUNT(JOB_0x0B_EMERGENCY_OXYGEN_STEPS), 0x0B };
 void biz_start_emergency_oxygen()
 {
   sys_job_start(JOB_0x0B_EMERGENCY_OXYGEN);
@@ -500,7 +572,7 @@ static const SysStep JOB_0x0C_AI_PARTY_DIZZY_STEPS[] = {
   { ws2812_all_breath_yellow,  5000  }, // 迷糊收束
   { ws2812_staute_green,       8000  },
 };
-static const SysJob JOB_0x0C_AI_PARTY_DIZZY = { JOB_0x0C_AI_PARTY_DIZZY_STEPS, JOB_COUNT(JOB_0x0C_AI_PARTY_DIZZY_STEPS) };
+static const SysJob JOB_0x0C_AI_PARTY_DIZZY = { JOB_0x0C_AI_PARTY_DIZZY_STEPS, JOB_COUNT(JOB_0x0C_AI_PARTY_DIZZY_STEPS), 0x0C };
 void biz_start_ai_party_dizzy()
 {
   sys_job_start(JOB_0x0C_AI_PARTY_DIZZY);
@@ -513,12 +585,13 @@ void biz_start_ai_party_dizzy()
 static const SysStep JOB_0x0D_GLITCH_SPASM_STEPS[] = {
   { fx_glitch_overload,     0     },  // 过载故障氛围
   { ws2812_err_2,            900   },  // 彩虹抽风
+  { nullptr,                 1500, "/clip/comet.wscl" },  // 彗星扫过（预烘焙片段，data/clip/）
   { ws2812_all_blink_yellow, 3200  },  // 乱码黄闪
   { ws2812_all_blink_red,    4800  },  // 危险红闪
   { ws2812_staute_yello,     6500  },  // 余震黄
   { ws2812_staute_green,     9000  },  // 回绿
 };
-static const SysJob JOB_0x0D_GLITCH_SPASM = { JOB_0x0D_GLITCH_SPASM_STEPS, JOB_COUNT(JOB_0x0D_GLITCH_SPASM_STEPS) };
+static const SysJob JOB_0x0D_GLITCH_SPASM = { JOB_0x0D_GLITCH_SPASM_STEPS, JOB_COUNT(JOB_0x0D_GLITCH_SPASM_STEPS), 0x0D };
 void biz_start_glitch_spasm()
 {
   sys_job_start(JOB_0x0D_GLITCH_SPASM);
@@ -545,9 +618,9 @@ static void laeser_point_knobs_scan(uint8_t Leaser_pin_1, uint8_t Leaser_pin_2,
   laser_pulse(Leaser_pin_2, 1600,250);
   laser_pulse(Leaser_pin_3, 2000,200);
 
-  io_set_level_at(Leaser_pin_2, HIGH,  300);
+  io_set_level_at(Leaser_pin_2, HAL_HIGH,  300);
   // t2 到：拉高（t2 = t1 + hold_ms）
-  io_set_level_at(Leaser_pin_2, LOW, 300 + 15000);
+  io_set_level_at(Leaser_pin_2, HAL_LOW, 300 + 15000);
 
   io_Continuous_flipping(Leaser_pin_1,10.0f,100,200);
   io_Continuous_flipping(Leaser_pin_3,10.0f,100,300);
@@ -558,7 +631,7 @@ static const SysStep JOB_0x0E_POINT_KNOBS_STEPS[] = {
   { fx_detect_done,  6000 },  // 20s 舵机动作里，灯先 6s 给到“分析完成”提示
   { ws2812_staute_green, 8000 },
 };
-static const SysJob JOB_0x0E_POINT_KNOBS = { JOB_0x0E_POINT_KNOBS_STEPS, JOB_COUNT(JOB_0x0E_POINT_KNOBS_STEPS) };
+static const SysJob JOB_0x0E_POINT_KNOBS = { JOB_0x0E_POINT_KNOBS_STEPS, JOB_COUNT(JOB_0x0E_POINT_KNOBS_STEPS), 0x0E };
 
 // void biz_start_point_knobs(uint8_t Leaser_pin_1 ,uint8_t Leaser_pin_2 ,uint8_t Leaser_pin_3)
 void biz_start_point_knobs(uint8_t Leaser_pin_1, uint8_t Leaser_pin_2, uint8_t Leaser_pin_3)
@@ -576,7 +649,7 @@ static const SysStep JOB_0x0F_DOUBT_STEPS[] = {
   { ws2812_all_breath_yellow, 0    },
   { ws2812_staute_green,      3000 },
 };
-static const SysJob JOB_0x0F_DOUBT = { JOB_0x0F_DOUBT_STEPS, JOB_COUNT(JOB_0x0F_DOUBT_STEPS) };
+static const SysJob JOB_0x0F_DOUBT = { JOB_0x0F_DOUBT_STEPS, JOB_COUNT(JOB_0x0F_DOUBT_STEPS), 0x0F };
 
 void biz_start_doubt()
 {
@@ -593,7 +666,7 @@ static const SysStep JOB_0x10_NAV_PORT_STEPS[] = {
   { ws2812_all_flow_green, 0    },
   { ws2812_staute_green,   5000 },
 };
-static const SysJob JOB_0x10_NAV_PORT = { JOB_0x10_NAV_PORT_STEPS, JOB_COUNT(JOB_0x10_NAV_PORT_STEPS) };
+static const SysJob JOB_0x10_NAV_PORT = { JOB_0x10_NAV_PORT_STEPS, JOB_COUNT(JOB_0x10_NAV_PORT_STEPS), 0x10 };
 
 void biz_start_nav_port()
 {
@@ -607,10 +680,10 @@ void biz_start_nav_port()
 //================================================================================
 
 void biz_err_3(uint8_t pin) {
-  pinMode(pin, OUTPUT);
-  io_set_level_at(pin, LOW,  300);
+  hal_gpio_output(pin);
+  io_set_level_at(pin, HAL_LOW,  300);
   // t2 到：拉高（t2 = t1 + hold_ms）
-  io_set_level_at(pin, HIGH, 300 + 8000);
+  io_set_level_at(pin, HAL_HIGH, 300 + 8000);
 }
 
 static const SysStep JOB_0x11_NERVOUS_APOLOGY_STEPS[] = {
@@ -618,7 +691,7 @@ static const SysStep JOB_0x11_NERVOUS_APOLOGY_STEPS[] = {
   { ws2812_all_breath_yellow,1800 },
   { ws2812_staute_green,     6000 },
 };
-static const SysJob JOB_0x11_NERVOUS_APOLOGY = { JOB_0x11_NERVOUS_APOLOGY_STEPS, JOB_COUNT(JOB_0x11_NERVOUS_APOLOGY_STEPS) };
+static const SysJob JOB_0x11_NERVOUS_APOLOGY = { JOB_0x11_NERVOUS_APOLOGY_STEPS, JOB_COUNT(JOB_0x11_NERVOUS_APOLOGY_STEPS), 0x11 };
 
 void biz_start_nervous_apology(uint8_t pin)
 {
@@ -637,7 +710,7 @@ static const SysStep JOB_0x12_ACCUSATION_STEPS[] = {
   { ws2812_all_blink_red,   4500 },
   { ws2812_staute_red,      6000 },
 };
-static const SysJob JOB_0x12_ACCUSATION = { JOB_0x12_ACCUSATION_STEPS, JOB_COUNT(JOB_0x12_ACCUSATION_STEPS) };
+static const SysJob JOB_0x12_ACCUSATION = { JOB_0x12_ACCUSATION_STEPS, JOB_COUNT(JOB_0x12_ACCUSATION_STEPS), 0x12 };
 
 void biz_start_accusation()
 {
@@ -654,7 +727,7 @@ static const SysStep JOB_0x13_POINT_POWER_STEPS[] = {
   { ws2812_all_flow_yellow,  800  },
   { ws2812_staute_green,     2500 },
 };
-static const SysJob JOB_0x13_POINT_POWER = { JOB_0x13_POINT_POWER_STEPS, JOB_COUNT(JOB_0x13_POINT_POWER_STEPS) };
+static const SysJob JOB_0x13_POINT_POWER = { JOB_0x13_POINT_POWER_STEPS, JOB_COUNT(JOB_0x13_POINT_POWER_STEPS), 0x13 };
 
 void biz_start_point_power()
 {
@@ -673,7 +746,7 @@ static const SysStep JOB_0x14_OVERLOAD_OVERRIDE_STEPS[] = {
   { fx_override_done,      12000 },
   { ws2812_staute_green,   13000 },
 };
-static const SysJob JOB_0x14_OVERLOAD_OVERRIDE = { JOB_0x14_OVERLOAD_OVERRIDE_STEPS, JOB_COUNT(JOB_0x14_OVERLOAD_OVERRIDE_STEPS) };
+static const SysJob JOB_0x14_OVERLOAD_OVERRIDE = { JOB_0x14_OVERLOAD_OVERRIDE_STEPS, JOB_COUNT(JOB_0x14_OVERLOAD_OVERRIDE_STEPS), 0x14 };
 
 void biz_start_overload_override()
 {
@@ -1,5 +1,5 @@
 #pragma once
-#include <Arduino.h>
+#include "../hal/hal.h"
 #include "../ws2812/ws2812.h"
 
 
@@ -9,11 +9,39 @@ typedef void (*SysFunc)();
 struct SysStep {
   SysFunc   func;
   uint32_t  offset_ms;   // 相对 job 开始时间
+  const char *clip = nullptr;   // 可选：这一步开始播放的灯效片段（LittleFS 路径，见 ws2812_clip.h）
 };
 
 struct SysJob {
   const SysStep* steps;
   uint16_t count;
+  uint8_t  id;           // 业务编号（对应语音词条，如 0x05），遥测用；0 = 未编号
+};
+
+// 运行中 job 的快照（遥测用）
+struct SysJobInfo {
+  uint8_t  slot;
+  uint8_t  id;
+  uint16_t cursor;       // 已执行到第几步
+  uint16_t count;
+  uint32_t elapsed_ms;
+};
+
+// 固定池占用（/metrics 用）
+enum : uint8_t {
+  SYS_POOL_IO_LEVEL = 0,   // MAX_IO_LEVEL_TASKS
+  SYS_POOL_JOBS,           // MAX_RUNNING_JOBS
+  SYS_POOL_DELAY,          // MAX_DELAY_TASKS
+  SYS_POOL_IO_FLIP,        // MAX_IO_TASKS
+  SYS_POOL_COUNT
+};
+
+struct SysPoolInfo {
+  const char *name;
+  uint8_t  used;         // 当前占用
+  uint8_t  cap;
+  uint8_t  peak;         // 开机以来最高占用
+  uint32_t full;         // 池满、投递失败的次数
 };
 
 #define JOB_COUNT(arr) (uint16_t)(sizeof(arr)/sizeof(arr[0]))
@@ -24,6 +52,8 @@ struct SysJob {
 // ===== 对外 API =====
 void sys_init();
 void sys_service();
+int  sys_job_snapshot(SysJobInfo *out, int max);   // 返回运行中的 job 数
+void sys_pool_stats(SysPoolInfo *out);             // out 至少 SYS_POOL_COUNT 项
 
 // 示例业务函数：触发某个引脚以 5Hz 翻转 10 次（你可以按需改/加）
 void biz_pulse_led(uint8_t Leaser_pin_1, uint8_t Leaser_pin_2, uint8_t Leaser_pin_3);
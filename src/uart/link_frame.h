@@ -0,0 +1,112 @@
+#pragma once
+
+/* =========================
+ * 二进制数据包（与主机共用，不依赖 Arduino）
+ *
+ *   0xA5 0x5A TYPE LEN PAYLOAD[LEN] CRC_L CRC_H
+ *   CRC = CRC-16/CCITT-FALSE(poly 0x1021, init 0xFFFF)，算 TYPE LEN PAYLOAD
+ *   多字节字段一律小端
+ *
+ * 和 0xAA 0x55 命令帧走同一个串口，由帧头区分
+ * ========================= */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define LINK_HEAD0        0xA5
+#define LINK_HEAD1        0x5A
+#define LINK_MAX_PAYLOAD  200
+#define LINK_OVERHEAD     6      // head0 head1 type len crcL crcH
+
+// 包类型
+#define LINK_TYPE_SETPOINT  0x10   // 实时设定点流
+#define LINK_TYPE_UP_BEGIN  0x20   // 上传开始 / 续传查询
+#define LINK_TYPE_UP_CHUNK  0x21   // 上传数据块
+#define LINK_TYPE_UP_END    0x22   // 上传结束，校验并替换
+#define LINK_TYPE_UP_ACK    0x2F   // 设备 -> 主机 应答
+#define LINK_TYPE_LED_FRAME 0x30   // 实时灯光帧分块（见 stream/led_in.h）
+
+/* =========================
+ * 设定点包载荷（20 字节）
+ *   seq   u16   序号，回绕递增
+ *   t_ms  u32   主机发送时间戳（毫秒）
+ *   off   i16 × 7  各轴 offset，顺序 R Y Z E A B C
+ * ========================= */
+#define LINK_SETPOINT_AXES  7
+#define LINK_SETPOINT_LEN   (2 + 4 + 2 * LINK_SETPOINT_AXES)
+
+/* =========================
+ * 灯光帧分块载荷
+ *   seq    u8    帧号（同一帧的分块相同）
+ *   first  u16   本块第一颗灯的灯号
+ *   flags  u8    bit0 = 本帧最后一块
+ *   rgb    n × 3
+ * ========================= */
+#define LINK_LED_HDR        4
+#define LINK_LED_FLAG_END   0x01
+#define LINK_LED_MAX_LEDS   ((LINK_MAX_PAYLOAD - LINK_LED_HDR) / 3)
+
+static inline uint16_t link_crc16(const uint8_t *d, size_t n, uint16_t crc = 0xFFFF)
+{
+  for (size_t i = 0; i < n; i++) {
+    crc ^= (uint16_t)d[i] << 8;
+    for (uint8_t k = 0; k < 8; k++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/* =========================
+ * 上传协议（停等 + 小窗口，可续传）
+ *   UP_BEGIN  u32 size, u32 crc32, u8 flags, name[]   flags bit0 = 丢弃已有的 .part 重新来
+ *   UP_CHUNK  u32 offset, data[]                     offset 必须等于设备当前写入位置
+ *   UP_END    （空）                                  设备核对边写边算的 crc32（续传时先重算 .part），通过后改名
+ *   UP_ACK    u8 status, u32 a, u32 b
+ *             BEGIN 应答：a = 续传位置，b = 已有部分的 crc32
+ *             CHUNK 应答：a = 新的写入位置
+ *             END   应答：a = 文件大小，b = 吞吐 bytes/s
+ * ========================= */
+#define LINK_UP_FLAG_RESTART  0x01
+#define LINK_UP_NAME_MAX      32
+#define LINK_UP_ACK_LEN       9
+
+enum : uint8_t {
+  LINK_UP_OK = 0,
+  LINK_UP_BAD_OFFSET,     // a = 设备当前写入位置，主机从这里重发
+  LINK_UP_IO_ERROR,
+  LINK_UP_CRC_MISMATCH,
+  LINK_UP_NO_SESSION,
+  LINK_UP_BAD_ARG,
+};
+
+// CRC-32/IEEE（与 zlib 相同），可分段累加：crc = link_crc32(d, n, crc)
+static inline uint32_t link_crc32(const uint8_t *d, size_t n, uint32_t crc = 0)
+{
+  crc = ~crc;
+  for (size_t i = 0; i < n; i++) {
+    crc ^= d[i];
+    for (uint8_t k = 0; k < 8; k++) {
+      crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+    }
+  }
+  return ~crc;
+}
+
+static inline void     link_put_u16(uint8_t *p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static inline void     link_put_u32(uint8_t *p, uint32_t v) { link_put_u16(p, (uint16_t)v); link_put_u16(p + 2, (uint16_t)(v >> 16)); }
+static inline uint16_t link_get_u16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline uint32_t link_get_u32(const uint8_t *p) { return link_get_u16(p) | ((uint32_t)link_get_u16(p + 2) << 16); }
+
+// 组一帧到 out（至少 len + LINK_OVERHEAD 字节），返回总长度；len 超限返回 0
+static inline size_t link_frame_encode(uint8_t type, const uint8_t *payload, uint8_t len, uint8_t *out)
+{
+  if (len > LINK_MAX_PAYLOAD) return 0;
+  out[0] = LINK_HEAD0;
+  out[1] = LINK_HEAD1;
+  out[2] = type;
+  out[3] = len;
+  for (uint8_t i = 0; i < len; i++) out[4 + i] = payload[i];
+  link_put_u16(&out[4 + len], link_crc16(&out[2], 2 + len));
+  return (size_t)len + LINK_OVERHEAD;
+}
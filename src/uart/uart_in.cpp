@@ -1,40 +1,231 @@
 #include "uart_in.h"
-HardwareSerial VoiceSerial(2);
+#include "../sys/spsc.h"
+#include <atomic>
+
+// ========================
+// 接收环形缓冲（单生产者 / 单消费者）
+// 生产者：UART 事件任务里的 onReceive 回调
+// 消费者：loop() 里的 readCmdFromUART()
+// ========================
+namespace {
+
+static_assert((UART_IN_RING_SIZE & (UART_IN_RING_SIZE - 1)) == 0, "ring size must be power of 2");
+
+static uint8_t g_ring[UART_IN_RING_SIZE];
+static std::atomic<uint16_t> g_head{0};   // 只由生产者写
+static std::atomic<uint16_t> g_tail{0};   // 只由消费者写
+
+static UartInStats g_stats = {};
+
+struct PacketHandlerSlot {
+  uint8_t type = 0;
+  bool    rt = false;          // true = 转给 uartInServiceRt() 在实时侧执行
+  UartPacketHandler handler = nullptr;
+};
+
+static PacketHandlerSlot g_pkt_handlers[UART_IN_MAX_PKT_HANDLERS];
+
+// 解析侧（readCmdFromUART）→ 实时侧（uartInServiceRt）
+struct RtPacket {
+  uint8_t type;
+  uint8_t len;
+  uint8_t payload[LINK_MAX_PAYLOAD];
+};
+static SpscQueue<RtPacket, UART_IN_RT_QUEUE> g_rt_pkts;
+
+static inline bool ring_push(uint8_t b)
+{
+  uint16_t h = g_head.load(std::memory_order_relaxed);
+  uint16_t next = (h + 1) & (UART_IN_RING_SIZE - 1);
+  if (next == g_tail.load(std::memory_order_acquire)) return false;   // 满
+  g_ring[h] = b;
+  g_head.store(next, std::memory_order_release);
+  return true;
+}
+
+static inline bool ring_pop(uint8_t &b)
+{
+  uint16_t t = g_tail.load(std::memory_order_relaxed);
+  if (t == g_head.load(std::memory_order_acquire)) return false;      // 空
+  b = g_ring[t];
+  g_tail.store((t + 1) & (UART_IN_RING_SIZE - 1), std::memory_order_release);
+  return true;
+}
+
+// UART 事件任务回调：把驱动缓冲里的数据整块搬进环形缓冲
+static void uart_on_receive()
+{
+  uint8_t buf[64];
+  size_t n;
+  while ((n = hal_uart_read(UART_IN_PORT, buf, sizeof(buf))) > 0) {
+    for (size_t i = 0; i < n; i++) {
+      if (ring_push(buf[i])) g_stats.rx_bytes++;
+      else                   g_stats.ring_overflows++;
+    }
+  }
+}
+
+static void uart_on_error(HalUartError err)
+{
+  switch (err) {
+    case HAL_UART_ERR_OVERFLOW:
+      g_stats.hw_overflows++;
+      break;
+    case HAL_UART_ERR_LINE:
+      g_stats.line_errors++;
+      break;
+  }
+}
+
+} // namespace
 
 void uartInInit(uint32_t baud, int rxPin, int txPin) {
-    VoiceSerial.begin(baud, SERIAL_8N1, rxPin, txPin);
+    hal_uart_begin(UART_IN_PORT, baud, rxPin, txPin, UART_IN_RING_SIZE, uart_on_receive, uart_on_error);
 }
 
-uint8_t parseAction(uint16_t cmd) {
-  switch (cmd) {
-        case CMD_test_1:     return test_1;
-        case CMD_test_2:     return test_2;
-        case CMD_test_3:     return test_3;
-        case CMD_test_4:     return test_4;
-        default:               return ACT_UNKNOWN;
+// CRC-8/ATM：poly 0x07, init 0x00, 不反转
+uint8_t uart_crc8(const uint8_t *data, size_t len)
+{
+  uint8_t crc = 0x00;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (uint8_t k = 0; k < 8; k++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
   }
+  return crc;
 }
 
+// 高字节为 0 的命令直接映射成语音词条编号，否则返回 0（无效）
+uint8_t uartCmdToVoiceId(uint16_t cmd)
+{
+  if ((cmd >> 8) != 0) return 0;
+  return (uint8_t)(cmd & 0xFF);
+}
 
+const UartInStats &uartInStats()
+{
+  return g_stats;
+}
 
-bool readCmdFromUART(uint16_t &cmd) {
-    static uint8_t frame[5];
-    static uint8_t index = 0;
+static bool add_handler(uint8_t type, UartPacketHandler handler, bool rt)
+{
+  for (int i = 0; i < UART_IN_MAX_PKT_HANDLERS; i++) {
+    if (g_pkt_handlers[i].handler == nullptr || g_pkt_handlers[i].type == type) {
+      g_pkt_handlers[i].type = type;
+      g_pkt_handlers[i].rt = rt;
+      g_pkt_handlers[i].handler = handler;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool uartInOnPacket(uint8_t type, UartPacketHandler handler)
+{
+  return add_handler(type, handler, false);
+}
+
+bool uartInOnPacketRt(uint8_t type, UartPacketHandler handler)
+{
+  return add_handler(type, handler, true);
+}
 
-    while (VoiceSerial.available() > 0) {
-        uint8_t b = VoiceSerial.read();
+// 实时侧：执行排队的数据包，每轮最多清空一次队列
+void uartInServiceRt()
+{
+  const RtPacket *p;
+  while ((p = g_rt_pkts.front()) != nullptr) {
+    for (int i = 0; i < UART_IN_MAX_PKT_HANDLERS; i++) {
+      if (g_pkt_handlers[i].handler && g_pkt_handlers[i].type == p->type) {
+        g_pkt_handlers[i].handler(p->payload, p->len);
+        break;
+      }
+    }
+    g_rt_pkts.release();
+  }
+}
 
-        if (index == 0 && b != 0xAA) continue;
-        if (index == 1 && b != 0x55) { index = 0; continue; }
-        if (index == 4 && b != 0xFB) { index = 0; continue; }
+// 发一个数据包给主机，返回写出的字节数（0 = 长度超限）
+size_t uartInSendPacket(uint8_t type, const uint8_t *payload, uint8_t len)
+{
+  uint8_t frame[LINK_MAX_PAYLOAD + LINK_OVERHEAD];
+  size_t n = link_frame_encode(type, payload, len, frame);
+  if (n == 0) return 0;
+  return hal_uart_write(UART_IN_PORT, frame, n);
+}
+
+static void dispatch_packet(uint8_t type, const uint8_t *payload, uint8_t len)
+{
+  for (int i = 0; i < UART_IN_MAX_PKT_HANDLERS; i++) {
+    if (!g_pkt_handlers[i].handler || g_pkt_handlers[i].type != type) continue;
+    if (!g_pkt_handlers[i].rt) {
+      g_pkt_handlers[i].handler(payload, len);
+      return;
+    }
+    RtPacket *q = g_rt_pkts.reserve();
+    if (!q) { g_stats.rt_drops++; return; }
+    q->type = type;
+    q->len = len;
+    memcpy(q->payload, payload, len);
+    g_rt_pkts.commit();
+    return;
+  }
+  g_stats.packets_unhandled++;
+}
+
+/**
+ * @brief  从环形缓冲里取出一帧命令（非阻塞）
+ *
+ * @param  cmd   输出：帧里的 16 位命令字
+ * @return true  取到一条 CRC 正确的命令
+ *
+ * @details
+ * 每次调用最多解析到一帧命令为止，剩下的字节留到下次。
+ * 途中遇到的 0xA5 0x5A 数据包直接交给 uartInOnPacket() 注册的处理函数；
+ * uartInOnPacketRt() 注册的排进队列，等实时侧 uartInServiceRt() 执行。
+ * 帧头/帧尾不对计 framing_errors，CRC 不对计 crc_errors。
+ */
+bool readCmdFromUART(uint16_t &cmd) {
+    static uint8_t frame[LINK_MAX_PAYLOAD + LINK_OVERHEAD];
+    static uint16_t index = 0;
+    static uint16_t need = 0;   // 当前帧总长度，0 = 还不知道
+
+    uint8_t b;
+    while (ring_pop(b)) {
+        if (index == 0) {
+            if (b != UART_FRAME_HEAD0 && b != LINK_HEAD0) { g_stats.framing_errors++; continue; }
+            need = (b == UART_FRAME_HEAD0) ? UART_FRAME_LEN : 0;
+        }
+        else if (index == 1) {
+            uint8_t h1 = (frame[0] == UART_FRAME_HEAD0) ? UART_FRAME_HEAD1 : LINK_HEAD1;
+            if (b != h1) { g_stats.framing_errors++; index = 0; continue; }
+        }
+        else if (index == 3 && frame[0] == LINK_HEAD0) {
+            if (b > LINK_MAX_PAYLOAD) { g_stats.framing_errors++; index = 0; continue; }
+            need = b + LINK_OVERHEAD;
+        }
 
         frame[index++] = b;
 
-        if (index == 5) {
-            index = 0;
-            cmd = (frame[2] << 8) | frame[3];
-            return true;
+        if (need == 0 || index < need) continue;
+        index = 0;
+
+        if (frame[0] == LINK_HEAD0) {
+            uint8_t len = frame[3];
+            uint16_t crc = link_get_u16(&frame[4 + len]);
+            if (link_crc16(&frame[2], 2 + len) != crc) { g_stats.crc_errors++; continue; }
+            g_stats.packets_ok++;
+            dispatch_packet(frame[2], &frame[4], len);
+            continue;
         }
+
+        if (frame[5] != UART_FRAME_TAIL) { g_stats.framing_errors++; continue; }
+        if (uart_crc8(&frame[2], 2) != frame[4]) { g_stats.crc_errors++; continue; }
+
+        g_stats.frames_ok++;
+        cmd = (frame[2] << 8) | frame[3];
+        return true;
     }
     return false;
 }
@@ -1,30 +1,68 @@
 #ifndef UART_IN_H
 #define UART_IN_H
-#include <Arduino.h>
+#include "../hal/hal.h"
+#include "link_frame.h"
 
 // UART 命令字（从语音模块过来的）
-#define CMD_test_1   0x0001
-#define CMD_test_2   0x0004
-#define CMD_test_3  0x0005
-#define CMD_test_4      0x0006
 #define CMD_BROADCAST_ON  0x0900
 #define CMD_BROADCAST_OFF 0x0A00
 
-// 返回动作编号（内部系统动作）
-#define test_1  1
-#define test_2 2
-#define test_3     3
-#define test_4   4
-#define ACT_LED_OFF  5
-#define LED_ON       6
-#define ACT_UNKNOWN  0
+/* =========================
+ * 串口与引脚
+ * 注意：原来 main.cpp 里的 RX 39 / TX 38 与舵机 R / C 冲突，这里改用空闲引脚
+ * ========================= */
+#define UART_IN_PORT     2          // hal_uart 端口号
+#define UART_IN_BAUD     115200
+#define UART_IN_RX_PIN   17
+#define UART_IN_TX_PIN   18
+
+/* =========================
+ * 命令帧（6 字节）
+ *   0xAA 0x55 CMD_H CMD_L CRC8 0xFB
+ *   CRC8 = CRC-8/ATM(poly 0x07, init 0x00)，只算 CMD_H CMD_L
+ * CMD_H == 0x00 时 CMD_L 就是语音词条编号，和 ASR 走同一套分发
+ * ========================= */
+#define UART_FRAME_HEAD0  0xAA
+#define UART_FRAME_HEAD1  0x55
+#define UART_FRAME_TAIL   0xFB
+#define UART_FRAME_LEN    6
+
+// 接收环形缓冲（必须是 2 的幂；要装得下上传窗口里的几个数据块）
+#define UART_IN_RING_SIZE 1024
+
+// 0xA5 0x5A 数据包的处理函数表容量（格式见 link_frame.h）
+#define UART_IN_MAX_PKT_HANDLERS 8
+// 要在实时侧执行的数据包（uartInOnPacketRt）排队的深度；解析在 IO 核、处理在实时核（见 cores.h）
+#define UART_IN_RT_QUEUE 8
+typedef void (*UartPacketHandler)(const uint8_t *payload, uint8_t len);
+
+// 接收统计（只增不减）
+struct UartInStats {
+  uint32_t rx_bytes;        // 进入环形缓冲的字节数
+  uint32_t frames_ok;       // 校验通过的帧
+  uint32_t packets_ok;      // 校验通过的数据包
+  uint32_t packets_unhandled; // 没有注册处理函数的数据包
+  uint32_t crc_errors;      // CRC 不对
+  uint32_t framing_errors;  // 帧头/帧尾不对，丢弃重新同步
+  uint32_t ring_overflows;  // 环形缓冲满，丢掉的字节数
+  uint32_t hw_overflows;    // 驱动 FIFO / 缓冲溢出次数
+  uint32_t line_errors;     // 帧错误 / 校验位错误 / break
+  uint32_t rt_drops;        // 实时侧队列满，丢掉的数据包
+};
 
-uint8_t parseAction(uint16_t cmd);
 bool readCmdFromUART(uint16_t &cmd);
 void uartInInit(uint32_t baud, int rxPin, int txPin);
 
+uint8_t uart_crc8(const uint8_t *data, size_t len);
+uint8_t uartCmdToVoiceId(uint16_t cmd);
+const UartInStats &uartInStats();
+bool uartInOnPacket(uint8_t type, UartPacketHandler handler);     // 在解析的任务里直接执行
+bool uartInOnPacketRt(uint8_t type, UartPacketHandler handler);   // 排队，由 uartInServiceRt() 执行
+void uartInServiceRt();                                            // 实时侧 loop 里调用
+size_t uartInSendPacket(uint8_t type, const uint8_t *payload, uint8_t len);
+
 
 
 
 
-#endif
\ No newline at end of file
+#endif
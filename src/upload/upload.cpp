@@ -0,0 +1,181 @@
+#include "upload.h"
+#include <stdio.h>
+#include "../ws2812/ws2812.h"
+#ifndef HAL_NATIVE
+#include "../webservo/web_assets.h"
+#endif
+
+namespace {
+
+static UploadStats g_stats = {};
+
+static HalFile  g_part = HAL_FILE_NONE;
+static char     g_path[LINK_UP_NAME_MAX + 1];
+static char     g_part_path[LINK_UP_NAME_MAX + 8];
+static uint32_t g_size = 0;         // 目标文件大小
+static uint32_t g_crc = 0;          // 目标文件 crc32
+static uint32_t g_written = 0;      // 已写入（含续传前的部分）
+static uint32_t g_run_crc = 0;      // 已写入部分的 crc32（边写边算，END 不用重读）
+static uint32_t g_start_ms = 0;
+static uint32_t g_start_bytes = 0;
+
+static void close_part()
+{
+  hal_fs_close(g_part);
+  g_part = HAL_FILE_NONE;
+}
+
+static void send_ack(uint8_t status, uint32_t a, uint32_t b)
+{
+  uint8_t p[LINK_UP_ACK_LEN];
+  p[0] = status;
+  link_put_u32(p + 1, a);
+  link_put_u32(p + 5, b);
+  uartInSendPacket(LINK_TYPE_UP_ACK, p, sizeof(p));
+}
+
+// 续传前把已有 .part 的内容过一遍 crc，分块读，不占大内存
+static uint32_t file_crc(const char *path, uint32_t &size)
+{
+  uint8_t buf[128];
+  uint32_t crc = 0;
+  size = 0;
+
+  HalFile f = hal_fs_open(path);
+  if (f == HAL_FILE_NONE) return 0;
+  size_t n;
+  while ((n = hal_fs_read(f, buf, sizeof(buf))) > 0) {
+    crc = link_crc32(buf, n, crc);
+    size += n;
+  }
+  hal_fs_close(f);
+  return crc;
+}
+
+static void on_begin(const uint8_t *p, uint8_t len)
+{
+  if (len < 10 || len - 9 > LINK_UP_NAME_MAX) { send_ack(LINK_UP_BAD_ARG, 0, 0); return; }
+
+  close_part();
+  g_stats.active = false;
+
+  g_size = link_get_u32(p);
+  g_crc  = link_get_u32(p + 4);
+  uint8_t flags = p[8];
+  memcpy(g_path, p + 9, len - 9);
+  g_path[len - 9] = '\0';
+  if (!upload_path_ok(g_path)) { send_ack(LINK_UP_BAD_ARG, 0, 0); return; }
+  snprintf(g_part_path, sizeof(g_part_path), "%s.part", g_path);
+
+  if (flags & LINK_UP_FLAG_RESTART) hal_fs_remove(g_part_path);
+
+  g_run_crc = file_crc(g_part_path, g_written);
+  if (g_written > g_size) {
+    hal_fs_remove(g_part_path);
+    g_written = 0;
+    g_run_crc = 0;
+  }
+
+  g_part = hal_fs_open_append(g_part_path);
+  if (g_part == HAL_FILE_NONE) { g_stats.io_errors++; send_ack(LINK_UP_IO_ERROR, 0, 0); return; }
+
+  g_stats.active = true;
+  g_start_ms = hal_millis();
+  g_start_bytes = g_written;
+  send_ack(LINK_UP_OK, g_written, g_run_crc);
+}
+
+static void on_chunk(const uint8_t *p, uint8_t len)
+{
+  if (!g_stats.active) { send_ack(LINK_UP_NO_SESSION, 0, 0); return; }
+  if (len < 4)         { send_ack(LINK_UP_BAD_ARG, g_written, 0); return; }
+
+  uint32_t offset = link_get_u32(p);
+  const uint8_t *data = p + 4;
+  uint8_t n = len - 4;
+
+  if (offset != g_written) {
+    g_stats.bad_offsets++;
+    send_ack(LINK_UP_BAD_OFFSET, g_written, 0);
+    return;
+  }
+  if (g_written + n > g_size) { send_ack(LINK_UP_BAD_ARG, g_written, 0); return; }
+
+  if (hal_fs_write(g_part, data, n) != n) {
+    g_stats.io_errors++;
+    send_ack(LINK_UP_IO_ERROR, g_written, 0);
+    return;
+  }
+  g_run_crc = link_crc32(data, n, g_run_crc);
+  g_written += n;
+  g_stats.bytes += n;
+  send_ack(LINK_UP_OK, g_written, 0);
+}
+
+static void on_end(const uint8_t *p, uint8_t len)
+{
+  (void)p; (void)len;
+  if (!g_stats.active) { send_ack(LINK_UP_NO_SESSION, 0, 0); return; }
+
+  close_part();
+  g_stats.active = false;
+
+  if (g_written != g_size) { send_ack(LINK_UP_BAD_OFFSET, g_written, 0); return; }
+  if (g_run_crc != g_crc) {
+    g_stats.crc_failures++;
+    hal_fs_remove(g_part_path);
+    send_ack(LINK_UP_CRC_MISMATCH, g_written, g_run_crc);
+    return;
+  }
+
+  if (!upload_swap(g_part_path, g_path)) {
+    g_stats.io_errors++;
+    send_ack(LINK_UP_IO_ERROR, g_written, 0);
+    return;
+  }
+
+  uint32_t el = hal_millis() - g_start_ms;
+  if (el == 0) el = 1;
+  g_stats.last_rate_bps = (uint32_t)((uint64_t)(g_written - g_start_bytes) * 1000 / el);
+  g_stats.sessions_ok++;
+  send_ack(LINK_UP_OK, g_written, g_stats.last_rate_bps);
+
+  hal_log("upload %s: %u bytes, %u B/s\n", g_path, (unsigned)g_written, (unsigned)g_stats.last_rate_bps);
+}
+
+} // namespace
+
+void upload_init()
+{
+  if (!hal_fs_begin()) {
+    hal_log("LittleFS mount failed\n");
+  }
+  uartInOnPacket(LINK_TYPE_UP_BEGIN, on_begin);
+  uartInOnPacket(LINK_TYPE_UP_CHUNK, on_chunk);
+  uartInOnPacket(LINK_TYPE_UP_END,   on_end);
+}
+
+const UploadStats &upload_stats()
+{
+  return g_stats;
+}
+
+// 只接受 "/xxx" 形式、不含 ".." 的路径
+bool upload_path_ok(const char *p)
+{
+  if (p[0] != '/') return false;
+  if (strstr(p, "..")) return false;
+  return true;
+}
+
+// LittleFS 的 rename 覆盖已有目标是原子操作：掉电后要么是旧文件要么是新文件，
+// 不会出现目标缺失的中间态，所以不要先 remove 再 rename
+bool upload_swap(const char *tmp_path, const char *path)
+{
+  if (!hal_fs_rename(tmp_path, path)) return false;
+#ifndef HAL_NATIVE
+  web_assets_invalidate();
+#endif
+  if (strcmp(path, WS2812_LAYOUT_PATH) == 0) ws2812_layout_request_reload();   // 新布局下一轮 loop 生效
+  return true;
+}
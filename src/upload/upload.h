@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../hal/hal.h"
+#include "../uart/uart_in.h"
+
+/* =========================
+ * 串口批量上传（动作 / 演出数据 -> LittleFS）
+ * 协议见 link_frame.h 的 UP_* 包；数据块直接从接收帧写进 <name>.part，
+ * 内存占用只有一帧，和文件大小无关；END 校验通过后改名成 <name>
+ * 文件只经 hal_fs_*，主机构建（HAL_NATIVE）也能跑，tools/link_host/link_loopback 拿它做回环测试
+ * ========================= */
+
+struct UploadStats {
+  uint32_t sessions_ok;     // 成功完成的上传
+  uint32_t crc_failures;    // END 校验失败
+  uint32_t bad_offsets;     // 乱序 / 重发的数据块
+  uint32_t io_errors;       // LittleFS 写失败
+  uint32_t bytes;           // 累计写入字节
+  uint32_t last_rate_bps;   // 最近一次上传的吞吐 bytes/s
+  bool     active;
+};
+
+void upload_init();
+const UploadStats &upload_stats();
+
+// 串口上传和 HTTP 上传共用
+bool upload_path_ok(const char *path);                   // 只接受 "/xxx"、不含 ".."
+bool upload_swap(const char *tmp_path, const char *path); // 临时文件换成正式文件
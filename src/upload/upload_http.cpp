@@ -0,0 +1,173 @@
+#include "upload_http.h"
+
+namespace {
+
+// 整个上传只用这一份静态状态；回调都在 AsyncTCP 任务里，不需要加锁
+struct HttpUpload {
+  AsyncWebServerRequest *owner;   // 当前占用上传的请求，nullptr = 空闲
+  File     f;
+  char     path[LINK_UP_NAME_MAX + 1];
+  char     tmp_path[LINK_UP_NAME_MAX + 8];
+  uint32_t expect_crc;
+  uint32_t crc;                   // 边写边算
+  uint32_t written;
+  uint32_t start_ms;
+  uint32_t heap_start;
+  uint32_t heap_min;
+  int      err;                   // 0 = 正常，否则是要回的 HTTP 状态码
+  const char *msg;
+};
+
+static HttpUpload g_up = {};
+static UploadHttpStats g_stats = {};
+
+static void fail(int code, const char *msg)
+{
+  if (g_up.err) return;
+  g_up.err = code;
+  g_up.msg = msg;
+  if (g_up.f) g_up.f.close();
+  if (g_up.tmp_path[0]) LittleFS.remove(g_up.tmp_path);
+}
+
+static inline void sample_heap()
+{
+  uint32_t h = ESP.getFreeHeap();
+  if (h < g_up.heap_min) g_up.heap_min = h;
+}
+
+// 连接断开：上传没走完就丢掉 .tmp
+static void on_disconnect(AsyncWebServerRequest *request)
+{
+  if (g_up.owner != request) return;
+  if (!g_up.err) {
+    g_stats.aborted++;
+    fail(499, "aborted");
+  }
+  g_up.owner = nullptr;
+  g_stats.active = false;
+}
+
+// 第一个数据块到达时调用；返回 false 表示这个请求不是当前上传的所有者
+static bool session_begin(AsyncWebServerRequest *request, const char *fallback_name)
+{
+  if (g_up.owner) return g_up.owner == request;
+
+  g_up.path[0] = '\0';
+  g_up.tmp_path[0] = '\0';
+  g_up.owner = request;
+  g_up.crc = 0;
+  g_up.written = 0;
+  g_up.err = 0;
+  g_up.msg = nullptr;
+  g_up.start_ms = millis();
+  g_up.heap_start = g_up.heap_min = ESP.getFreeHeap();
+  g_stats.active = true;
+  request->onDisconnect([request]() { on_disconnect(request); });
+
+  const char *name = fallback_name;
+  if (request->hasParam("name")) name = request->getParam("name")->value().c_str();
+  if (!name || strlen(name) > LINK_UP_NAME_MAX || !upload_path_ok(name)) { fail(400, "bad name"); return true; }
+  strcpy(g_up.path, name);
+  snprintf(g_up.tmp_path, sizeof(g_up.tmp_path), "%s.tmp", g_up.path);
+
+  if (!request->hasParam("crc")) { fail(400, "missing crc"); return true; }
+  g_up.expect_crc = strtoul(request->getParam("crc")->value().c_str(), nullptr, 16);
+
+  // 旧文件在替换前一直占着空间，新文件得另外放得下
+  size_t total = request->contentLength();
+  if (total > LittleFS.totalBytes() - LittleFS.usedBytes()) { fail(507, "no space"); return true; }
+
+  g_up.f = LittleFS.open(g_up.tmp_path, "w");
+  if (!g_up.f) { g_stats.io_errors++; fail(500, "open failed"); }
+  return true;
+}
+
+static void session_write(AsyncWebServerRequest *request, const uint8_t *data, size_t len)
+{
+  if (g_up.owner != request || g_up.err) return;
+  if (g_up.f.write(data, len) != len) {
+    g_stats.io_errors++;
+    fail(500, "write failed");
+    return;
+  }
+  g_up.crc = link_crc32(data, len, g_up.crc);
+  g_up.written += len;
+  g_stats.bytes += len;
+  sample_heap();
+}
+
+// 请求收完后回结果
+static void session_finish(AsyncWebServerRequest *request)
+{
+  if (g_up.owner != request) {
+    g_stats.rejected++;
+    if (g_up.owner) request->send(409, "text/plain", "upload busy");
+    else            request->send(400, "text/plain", "empty body");   // 没有数据块到达过
+    return;
+  }
+
+  if (!g_up.err) {
+    g_up.f.close();
+    if (g_up.written == 0)                  fail(400, "empty body");
+    else if (g_up.crc != g_up.expect_crc) { g_stats.crc_failures++; fail(422, "crc mismatch"); }
+    else if (!upload_swap(g_up.tmp_path, g_up.path)) { g_stats.io_errors++; fail(500, "rename failed"); }
+  }
+
+  g_up.owner = nullptr;
+  g_stats.active = false;
+
+  if (g_up.err) {
+    if (g_up.err == 400 || g_up.err == 507) g_stats.rejected++;
+    request->send(g_up.err, "text/plain", g_up.msg);
+    return;
+  }
+
+  uint32_t el = millis() - g_up.start_ms;
+  if (el == 0) el = 1;
+  g_stats.sessions_ok++;
+  g_stats.last_rate_bps = (uint32_t)((uint64_t)g_up.written * 1000 / el);
+  g_stats.last_heap_peak = g_up.heap_start - g_up.heap_min;
+
+  char buf[128];
+  snprintf(buf, sizeof(buf),
+           "{\"size\":%u,\"crc\":\"%08x\",\"ms\":%u,\"rate_bps\":%u,\"heap_peak\":%u}",
+           (unsigned)g_up.written, (unsigned)g_up.crc, (unsigned)el,
+           (unsigned)g_stats.last_rate_bps, (unsigned)g_stats.last_heap_peak);
+  request->send(200, "application/json", buf);
+
+  hal_log("http upload %s: %u bytes, %u B/s, heap peak %u\n",
+          g_up.path, (unsigned)g_up.written, (unsigned)g_stats.last_rate_bps,
+          (unsigned)g_stats.last_heap_peak);
+}
+
+} // namespace
+
+void upload_http_register(AsyncWebServer &server)
+{
+  server.on("/api/upload", HTTP_POST,
+    [](AsyncWebServerRequest *request){
+      session_finish(request);
+    },
+    // multipart 表单
+    [](AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len, bool final){
+      (void)final;
+      if (index == 0) {
+        char name[LINK_UP_NAME_MAX + 2];
+        snprintf(name, sizeof(name), "/%s", filename.c_str());
+        if (!session_begin(request, name)) return;
+      }
+      session_write(request, data, len);
+    },
+    // 原始 body
+    [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+      (void)total;
+      if (index == 0 && !session_begin(request, nullptr)) return;
+      session_write(request, data, len);
+    });
+}
+
+const UploadHttpStats &upload_http_stats()
+{
+  return g_stats;
+}
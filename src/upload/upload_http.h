@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+#include "upload.h"
+
+/* =========================
+ * HTTP 上传（动作 / 演出数据 / 网页 -> LittleFS）
+ *   POST /api/upload?name=/show1.seq&crc=1a2b3c4d
+ *     body 为文件原始字节（Content-Type: application/octet-stream），
+ *     或 multipart 表单的单个文件（没给 name 时用表单里的文件名）
+ *   crc = 整个文件的 CRC-32/IEEE（十六进制），必填
+ *
+ * 数据块到一个写一个，直接进 <name>.tmp，内存只有这里的固定状态，和文件大小无关；
+ * 收完核对 crc，通过后原子替换 <name>。同一时间只允许一个上传，其余回 409。
+ * 连接中途断开会删掉 .tmp，原文件不受影响。
+ *
+ * 成功回 {"size":..,"crc":"..","ms":..,"rate_bps":..,"heap_peak":..}
+ *   heap_peak = 上传期间堆空闲的最大跌幅（含 TCP 缓冲），看上传对内存的实际压力
+ * ========================= */
+
+struct UploadHttpStats {
+  uint32_t sessions_ok;
+  uint32_t crc_failures;
+  uint32_t io_errors;
+  uint32_t aborted;         // 中途断开
+  uint32_t rejected;        // 参数错误 / 忙 / 空间不够
+  uint32_t bytes;           // 累计写入字节
+  uint32_t last_rate_bps;   // 最近一次上传的吞吐 bytes/s
+  uint32_t last_heap_peak;  // 最近一次上传的堆空闲最大跌幅
+  bool     active;
+};
+
+void upload_http_register(AsyncWebServer &server);
+const UploadHttpStats &upload_http_stats();
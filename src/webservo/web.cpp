@@ -1,4 +1,12 @@
 #include "web.h"
+#include "../stream/stream_in.h"
+#include "web_assets.h"
+#include "../upload/upload_http.h"
+#include "../metrics/metrics.h"
+#include "../sys/bus.h"
+#include "../show/show.h"
+#include "../sys/spsc.h"
+#include <atomic>
 
 
 
@@ -8,12 +16,250 @@ const char* password = "12345678";  // 替换为你的Wi-Fi密码
 
 // 创建 Web 服务器实例
 AsyncWebServer server(80);
+AsyncWebSocket ws("/ws");
 
-static inline int clamp180(int v){
+// ========================
+// WebSocket 控制：按轴合并
+// 生产者：AsyncTCP 任务里的 ws 事件
+// 消费者：loop() 里的 web_service()（1 号核）
+// ========================
+static std::atomic<int16_t>  g_pending[AX_N];
+static std::atomic<uint8_t>  g_pending_mask{0};
+static WebCtrlStats g_ctrl_stats = {};
+static bool g_web_started = false;
+
+static inline int clamp180(long v){
   if (v < 0) return 0;
   if (v > 180) return 180;
   return v;
 }
+
+static const char AXIS_NAMES[AX_N + 1] = "RYZEABC";
+
+static int axis_index(const char *name)
+{
+  if (!name || name[0] == '\0' || name[1] != '\0') return -1;
+  const char *p = strchr(AXIS_NAMES, name[0]);
+  return p ? (int)(p - AXIS_NAMES) : -1;
+}
+
+// 参数只借用库里已经解析好的值（const char*），处理函数里不构造 / 拷贝 String
+static const char *param_str(AsyncWebServerRequest *request, const char *name)
+{
+  const AsyncWebParameter *p = request->getParam(name);
+  return p ? p->value().c_str() : nullptr;
+}
+
+// 十进制整数，整串都得是数字（可带符号）；没给或不合法返回 false
+static bool param_int(AsyncWebServerRequest *request, const char *name, long &out)
+{
+  const char *s = param_str(request, name);
+  if (!s || *s == '\0') return false;
+  char *end;
+  out = strtol(s, &end, 10);
+  return *end == '\0';
+}
+
+static const int AXIS_DEFAULT[AX_N] = {
+  R_Angle_Default, Y_Angle_Default, Z_Angle_Default, E_Angle_Default,
+  A_Angle_Default, B_Angle_Default, C_Angle_Default,
+};
+
+static void reply_busy(AsyncWebServerRequest *request)
+{
+  request->send(503, "text/plain", "busy");
+}
+static void ws_on_setpoint(const uint8_t *data, size_t len)
+{
+  if (len < 2) { g_ctrl_stats.bad_frames++; return; }
+
+  uint8_t mask = data[1];
+  size_t need = 2;
+  for (int i = 0; i < AX_N; i++) if (mask & (1 << i)) need += 2;
+  if (len < need || (mask >> AX_N) != 0) { g_ctrl_stats.bad_frames++; return; }
+
+  const uint8_t *p = data + 2;
+  uint8_t prev = g_pending_mask.load(std::memory_order_relaxed);
+  for (int i = 0; i < AX_N; i++) {
+    if (!(mask & (1 << i))) continue;
+    g_pending[i].store((int16_t)(p[0] | (p[1] << 8)), std::memory_order_relaxed);
+    p += 2;
+    g_ctrl_stats.values++;
+    if (prev & (1 << i)) g_ctrl_stats.coalesced++;
+  }
+  g_pending_mask.fetch_or(mask, std::memory_order_release);
+  g_ctrl_stats.frames++;
+}
+
+static void ws_on_event(AsyncWebSocket *server, AsyncWebSocketClient *client,
+                        AwsEventType type, void *arg, uint8_t *data, size_t len)
+{
+  if (type != WS_EVT_DATA) return;
+
+  AwsFrameInfo *info = (AwsFrameInfo *)arg;
+  // 控制帧都很小，只处理单帧完整的二进制消息
+  if (!info->final || info->index != 0 || info->len != len || info->opcode != WS_BINARY) {
+    g_ctrl_stats.bad_frames++;
+    return;
+  }
+  if (len > 0 && data[0] == WS_FRAME_SETPOINT) ws_on_setpoint(data, len);
+  else g_ctrl_stats.bad_frames++;
+}
+
+// ========================
+// 遥测：1 号核只抄一份状态快照进队列，0 号核组帧、发给客户端
+// 快照是纯数据拷贝；ws.binaryAll / cleanupClients 这些碰 AsyncTCP 的都在 IO 侧
+// ========================
+struct TelemetrySnap {
+  uint32_t   ms;
+  int16_t    off[AX_N];
+  uint8_t    flags;
+  uint8_t    seq_id, seg_idx, seg_count;
+  uint8_t    nparts;
+  uint8_t    modes[WS2812_PART_MAX];
+  uint8_t    njobs;
+  SysJobInfo jobs[TELEMETRY_MAX_JOBS];
+};
+static SpscQueue<TelemetrySnap, 2> g_snaps;        // 实时 -> IO
+static std::atomic<bool> g_have_clients{false};    // IO 侧写：没客户端时实时侧连快照都不抄
+
+static uint8_t g_telemetry[TELEMETRY_MAX_LEN];
+
+static inline uint8_t *put_u32(uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+  return p + 4;
+}
+
+// 实时侧：抄当前状态（只读本核的数据，不碰网络）
+static void telemetry_capture(uint32_t now)
+{
+  static uint32_t last_ms = 0;
+  if (now - last_ms < TELEMETRY_PERIOD_MS) return;
+  last_ms = now;
+  if (!g_have_clients.load(std::memory_order_relaxed)) return;
+
+  TelemetrySnap *s = g_snaps.reserve();
+  if (!s) return;                        // IO 侧还没取走上一帧，这帧不抄
+  s->ms = now;
+  Servo_GetOffsets(s->off);
+
+  ServoPlayerState st;
+  Servo_GetPlayerState(st);
+  s->flags = (st.running ? 0x01 : 0) | (stream_in_active() ? 0x02 : 0) |
+             (ws2812_power_stats().limiting ? 0x04 : 0);
+  s->seq_id = st.seq_id;
+  s->seg_idx = st.seg_idx;
+  s->seg_count = st.seg_count;
+
+  s->nparts = ws2812_part_count();
+  for (uint8_t i = 0; i < s->nparts; i++) s->modes[i] = ws2812_part_mode(i);
+  s->njobs = (uint8_t)sys_job_snapshot(s->jobs, TELEMETRY_MAX_JOBS);
+  g_snaps.commit();
+}
+
+// IO 侧：快照组成一帧遥测，返回长度
+static size_t telemetry_build(uint8_t *buf, const TelemetrySnap &s)
+{
+  uint8_t *p = buf;
+  *p++ = WS_FRAME_TELEMETRY;
+  p = put_u32(p, s.ms);
+  for (int i = 0; i < AX_N; i++) {
+    *p++ = (uint8_t)s.off[i];
+    *p++ = (uint8_t)(s.off[i] >> 8);
+  }
+  *p++ = s.flags;
+  *p++ = s.seq_id;
+  *p++ = s.seg_idx;
+  *p++ = s.seg_count;
+
+  *p++ = s.nparts;
+  for (uint8_t i = 0; i < s.nparts; i++) *p++ = s.modes[i];
+
+  *p++ = s.njobs;
+  for (uint8_t i = 0; i < s.njobs; i++) {
+    *p++ = s.jobs[i].id;
+    *p++ = (uint8_t)s.jobs[i].cursor;
+    *p++ = (uint8_t)s.jobs[i].count;
+    p = put_u32(p, s.jobs[i].elapsed_ms);
+  }
+  return (size_t)(p - buf);
+}
+
+static void telemetry_send()
+{
+  const TelemetrySnap *s;
+  while ((s = g_snaps.front()) != nullptr) {
+    if (ws.count() != 0) {
+      // 有客户端积压时本帧直接跳过，不往队列里堆
+      if (!ws.availableForWriteAll()) {
+        g_ctrl_stats.telemetry_skipped++;
+      } else {
+        size_t len = telemetry_build(g_telemetry, *s);
+        ws.binaryAll(g_telemetry, len);
+        g_ctrl_stats.telemetry_sent++;
+      }
+    }
+    g_snaps.release();   // 抄完快照后客户端都走了的，也在这里丢掉
+  }
+}
+
+/**
+ * @brief  Web 控制维护，实时侧（loop() 里持续调用）
+ *
+ * @details
+ * 按 WEB_CTRL_PERIOD_MS 周期取一次合并后的各轴最新值（REST 命令走事件总线，见 bus.h），
+ * 没变的轴沿用当前 offset，一次性经 Servo_ApplyLive() 写出。
+ * 按 TELEMETRY_PERIOD_MS 抄一份遥测快照交给 web_io_service()，这里不做任何网络操作。
+ */
+void web_service()
+{
+  if (!g_web_started) return;
+
+  static uint32_t last_ms = 0;
+  uint32_t now = millis();
+  telemetry_capture(now);
+  if (now - last_ms < WEB_CTRL_PERIOD_MS) return;
+  last_ms = now;
+
+  uint8_t mask = g_pending_mask.exchange(0, std::memory_order_acquire);
+  if (mask) {
+    int16_t off[AX_N];
+    Servo_GetOffsets(off);
+    for (int i = 0; i < AX_N; i++) {
+      if (mask & (1 << i)) off[i] = g_pending[i].load(std::memory_order_relaxed);
+    }
+    Servo_ApplyLive(off);
+    g_ctrl_stats.applied++;
+  }
+}
+
+/**
+ * @brief  Web 网络侧维护，IO 侧（io_step 里调用，拆核时在 0 号核）
+ *
+ * @details
+ * 把实时侧抄好的遥测快照组帧推给所有 /ws 客户端，每秒清理一次断开的客户端。
+ */
+void web_io_service()
+{
+  if (!g_web_started) return;
+
+  g_have_clients.store(ws.count() != 0, std::memory_order_relaxed);
+  telemetry_send();
+
+  static uint32_t last_cleanup_ms = 0;
+  uint32_t now = millis();
+  if (now - last_cleanup_ms > 1000) {
+    last_cleanup_ms = now;
+    ws.cleanupClients();
+  }
+}
+
+const WebCtrlStats &web_ctrl_stats()
+{
+  return g_ctrl_stats;
+}
+
 void wifi_init() {
   // 1) 挂载 LittleFS
   if (!LittleFS.begin(true)) {
@@ -38,29 +284,137 @@ void wifi_init() {
   Serial.print("AP IP=");
   Serial.println(ip);
 
-  // 3) 主页：直接给 data/index.html
-  server.serveStatic("/", LittleFS, "/").setDefaultFile("index.html");
+  // 3) 主页等静态文件：gzip + ETag + 内存缓存，见 web_assets.cpp
+  //    挂在 onNotFound 上，保证 /api/* 和 /ws 先匹配
+  server.onNotFound([](AsyncWebServerRequest *request){
+    if (request->method() != HTTP_GET) {
+      request->send(405, "text/plain", "method not allowed");
+      return;
+    }
+    web_assets_handle(request);
+  });
 
-  // 4) API：控制舵机
+  // 4) API：都走播放器，不直接写舵机
   server.on("/api/servo", HTTP_GET, [](AsyncWebServerRequest *request){
-    if (!request->hasParam("name") || !request->hasParam("value")) {
+    const char *name = param_str(request, "name");
+    if (!name || !request->hasParam("value")) {
       request->send(400, "text/plain", "missing name/value");
       return;
     }
 
-    String name = request->getParam("name")->value();
-    int value = clamp180(request->getParam("value")->value().toInt());
-
-    if (name == "Y")      Y.write(value);
-    else if (name == "Z") Z.write(value);
-    else if (name == "E") E.write(value);
-    else {
+    int axis = axis_index(name);
+    if (axis < 0 || (axis != AX_Y && axis != AX_Z && axis != AX_E)) {
       request->send(400, "text/plain", "bad name");
       return;
     }
+    long raw;
+    if (!param_int(request, "value", raw)) {
+      request->send(400, "text/plain", "bad value");
+      return;
+    }
+    int value = clamp180(raw);
+
+    BusEvent *c = bus_reserve(BUS_SRC_WEB);
+    if (!c) { reply_busy(request); return; }
+    c->kind = BUS_EV_POSE;
+    c->mask = (uint8_t)(1 << axis);
+    c->dur_ms = WEB_SERVO_MOVE_MS;
+    c->off[axis] = (int16_t)(value - AXIS_DEFAULT[axis]);
+    bus_commit(BUS_SRC_WEB);
+
+    request->send(200, "text/plain", "OK");
+  });
+
+  server.on("/api/show", HTTP_GET, [](AsyncWebServerRequest *request){
+    if (!request->hasParam("id")) {
+      request->send(400, "text/plain", "missing id");
+      return;
+    }
+    long id;
+    if (!param_int(request, "id", id) || id <= 0 || id > 0xFF) {
+      request->send(400, "text/plain", "bad id");
+      return;
+    }
+    if (!show_exists((uint8_t)id)) {
+      request->send(404, "text/plain", "no such show");
+      return;
+    }
+
+    if (!bus_publish(BUS_SRC_WEB, BUS_EV_SHOW, (uint8_t)id)) { reply_busy(request); return; }
+
+    request->send(200, "text/plain", "OK");
+  });
+
+  server.on("/api/pose", HTTP_GET, [](AsyncWebServerRequest *request){
+    BusEvent *c = bus_reserve(BUS_SRC_WEB);
+    if (!c) { reply_busy(request); return; }
+
+    c->mask = 0;
+    for (int i = 0; i < AX_N; i++) {
+      const char name[2] = { AXIS_NAMES[i], '\0' };
+      if (!request->hasParam(name)) continue;
+      long v;
+      if (!param_int(request, name, v) || v < INT16_MIN || v > INT16_MAX) {
+        request->send(400, "text/plain", "bad offset");
+        return;
+      }
+      c->off[i] = (int16_t)v;
+      c->mask |= (uint8_t)(1 << i);
+    }
+    if (c->mask == 0) {
+      request->send(400, "text/plain", "no axis");
+      return;
+    }
+
+    long ms = 500;
+    if (request->hasParam("ms") && !param_int(request, "ms", ms)) {
+      request->send(400, "text/plain", "bad ms");
+      return;
+    }
+    if (ms < 0) ms = 0;
+    if (ms > WEB_POSE_MAX_MS) ms = WEB_POSE_MAX_MS;
+    c->kind = BUS_EV_POSE;
+    c->dur_ms = (uint16_t)ms;
+    bus_commit(BUS_SRC_WEB);
 
     request->send(200, "text/plain", "OK");
   });
 
+  server.on("/api/stop", HTTP_GET, [](AsyncWebServerRequest *request){
+    if (!bus_publish(BUS_SRC_WEB, BUS_EV_STOP, 0)) { reply_busy(request); return; }
+
+    request->send(200, "text/plain", "OK");
+  });
+
+  server.on("/api/status", HTTP_GET, [](AsyncWebServerRequest *request){
+    ServoPlayerState st;
+    Servo_GetPlayerState(st);
+    int progress = st.seg_count ? (st.running ? st.seg_idx * 100 / st.seg_count : 100) : 0;
+
+    char buf[96];
+    snprintf(buf, sizeof(buf),
+             "{\"busy\":%s,\"seq\":%u,\"seg\":%u,\"segs\":%u,\"progress\":%d}",
+             st.running ? "true" : "false", st.seq_id, st.seg_idx, st.seg_count, progress);
+    request->send(200, "application/json", buf);
+  });
+
+  // 运行指标，见 metrics.h（回调都在 AsyncTCP 一个任务里串行执行，静态缓冲不会被并发写）
+  server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request){
+    static char buf[METRICS_TEXT_MAX];
+    metrics_format(buf, sizeof(buf));
+    request->send(200, "text/plain; version=0.0.4", buf);
+  });
+
+  // 上传动作 / 演出数据，见 upload_http.h
+  upload_http_register(server);
+
+  // 5) WebSocket：滑块实时控制
+  ws.onEvent(ws_on_event);
+  server.addHandler(&ws);
+
   server.begin();
+  g_web_started = true;
+
+  // 6) 灯光台实时帧（Art-Net / E1.31）
+  led_in_udp_begin();
 }
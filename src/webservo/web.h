@@ -5,15 +5,73 @@
 #include <ESPAsyncWebServer.h>
 #include <LittleFS.h>
 #include "../servo/servo_in.h"
+#include "../sys/sys.h"
+#include "../stream/led_in.h"
 
-extern Servo E; 
-extern Servo Y; 
-extern Servo Z; 
+extern HalServo E; 
+extern HalServo Y; 
+extern HalServo Z; 
 
+/* =========================
+ * WebSocket 实时控制 /ws
+ * 二进制帧：
+ *   [0]    WS_FRAME_SETPOINT
+ *   [1]    轴掩码，bit i 对应 AX_i
+ *   [2..]  掩码里每个置位轴一个 int16 offset（小端），按轴号从小到大
+ * 同一控制周期内收到的多帧按轴合并，只取每轴最新值
+ * ========================= */
+#define WS_FRAME_SETPOINT   0x01
+#define WEB_CTRL_PERIOD_MS  20      // 控制周期（与舵机 50Hz 对齐）
+
+/* =========================
+ * 遥测（设备 -> 所有 /ws 客户端，固定频率推送）
+ *   [0]      WS_FRAME_TELEMETRY
+ *   [1..4]   u32 millis
+ *   [5..18]  i16 × AX_N 当前 offset（AxisState.o）
+ *   [19]     标志 bit0 = 动作播放中，bit1 = 串口实时流中，bit2 = 灯带电流限流中
+ *   [20..22] 动作编号 SEQ_ID_*，当前段，总段数
+ *   [23]     分区数 P，后跟 P 字节分区模式（ws2812_mode_t）
+ *   ...      运行中 job 数 J，后跟 J × { id u8, cursor u8, count u8, elapsed_ms u32 }
+ * 实时侧只抄状态快照（SPSC 交给 IO 侧），组帧和广播在 IO 侧；帧在静态缓冲里组好，不做动态拼接
+ * ========================= */
+#define WS_FRAME_TELEMETRY     0x02
+#define TELEMETRY_PERIOD_MS    100
+#define TELEMETRY_MAX_JOBS     6
+#define TELEMETRY_MAX_LEN      (24 + WS2812_PART_MAX + 1 + TELEMETRY_MAX_JOBS * 7)
+
+struct WebCtrlStats {
+  uint32_t frames;       // 收到的控制帧
+  uint32_t values;       // 帧里带的轴值
+  uint32_t coalesced;    // 被同周期更新值覆盖掉的轴值
+  uint32_t applied;      // 实际写舵机的周期数
+  uint32_t bad_frames;   // 格式不对
+  uint32_t telemetry_sent;     // 推送的遥测帧
+  uint32_t telemetry_skipped;  // 客户端发送队列满而跳过的遥测帧
+};
+
+/* =========================
+ * REST 控制（全部经播放器，与语音命令同样的平滑和安全范围）
+ *   GET /api/show?id=5                     按语音词条编号启动演出（舵机 + 灯效/激光），没有这个演出回 404
+ *   GET /api/pose?R=10&Y=-20&ms=600        多轴姿态插值，未给的轴保持不动
+ *   GET /api/stop                          停止当前动作（舵机停在原地）
+ *   GET /api/status                        {"busy":..,"seq":..,"seg":..,"segs":..,"progress":..}
+ *   GET /api/servo?name=Y&value=90         兼容旧接口：绝对角度，转成 offset 走 /api/pose
+ *   POST /api/upload?name=/x.seq&crc=..    上传文件到 LittleFS（见 upload_http.h）
+ *                                          name=/led_layout.txt 时灯带分区布局立即重新加载
+ *   GET /metrics                           运行指标（见 metrics.h）
+ * 数字参数整串都得是十进制整数，否则回 400；处理函数只借用参数的 const char*，不拼 String
+ * Web 回调跑在 AsyncTCP 任务里，命令发到事件总线（BUS_SRC_WEB，见 bus.h），
+ * 总线满时回 503，由 loop() 里的 bus_service() 执行
+ * ========================= */
+#define WEB_POSE_MAX_MS    10000
+#define WEB_SERVO_MOVE_MS  150     // /api/servo 的插值时间
 
 void wifi_init();
+void web_service();      // loop()：轴设定值落到舵机、抄遥测快照，不碰网络
+void web_io_service();   // io_step()：遥测组帧广播、清理断开的客户端
+const WebCtrlStats &web_ctrl_stats();
 
 
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,244 @@
+#include "web_assets.h"
+#include "../uart/link_frame.h"
+#include <atomic>
+
+namespace {
+
+struct AssetSlot {
+  bool     used = false;
+  bool     gzip = false;
+  bool     tried_gz = false;  // 装载时找过 .gz（gzip=false 说明这个文件没有 .gz）
+  char     path[ASSET_PATH_MAX];
+  char     etag[12];          // "xxxxxxxx"（含引号）
+  uint8_t *data = nullptr;
+  size_t   len = 0;
+  uint8_t  cap_class = 0;     // 记录分配大小档，清缓存后同档复用，不反复 malloc/free
+  uint8_t  refs = 0;          // 正在发送这块内存的请求数，非 0 时不能被覆盖
+};
+
+// 不进缓存的大文件只记 ETag：第一次打开时整文件算一遍 crc，之后按路径查
+struct AssetTag {
+  bool used = false;
+  bool gzip = false;
+  char path[ASSET_PATH_MAX];
+  char etag[12];
+};
+
+static AssetSlot g_slots[ASSET_CACHE_SLOTS];
+static AssetTag g_tags[ASSET_TAG_SLOTS];
+static AssetStats g_stats = {};
+static uint8_t g_next_victim = 0;
+static uint8_t g_next_tag = 0;
+
+// 缓存槽只在 AsyncTCP 任务里改；别的任务（串口上传在 loop 里）只递增代号，
+// 下一个请求进来时发现代号变了再清
+static std::atomic<uint32_t> g_gen{0};
+static uint32_t g_seen_gen = 0;
+
+static const char *content_type(const char *path)
+{
+  const char *ext = strrchr(path, '.');
+  if (!ext)                   return "application/octet-stream";
+  if (!strcmp(ext, ".html"))  return "text/html";
+  if (!strcmp(ext, ".js"))    return "application/javascript";
+  if (!strcmp(ext, ".css"))   return "text/css";
+  if (!strcmp(ext, ".json"))  return "application/json";
+  if (!strcmp(ext, ".svg"))   return "image/svg+xml";
+  if (!strcmp(ext, ".png"))   return "image/png";
+  if (!strcmp(ext, ".ico"))   return "image/x-icon";
+  return "application/octet-stream";
+}
+
+// 客户端收 gzip：优先 .gz 的槽，没有 .gz 的文件也认原文件的槽；不收 gzip：只认原文件
+static AssetSlot *find(const char *path, bool accept_gz)
+{
+  for (auto &s : g_slots) {
+    if (!s.used || strcmp(s.path, path)) continue;
+    if (accept_gz ? (s.gzip || s.tried_gz) : !s.gzip) return &s;
+  }
+  return nullptr;
+}
+
+static bool accepts_gzip(AsyncWebServerRequest *request)
+{
+  if (!request->hasHeader("Accept-Encoding")) return false;
+  return strstr(request->getHeader("Accept-Encoding")->value().c_str(), "gzip") != nullptr;
+}
+
+// 打开资源：客户端收 gzip 时先找 .gz，再找原文件
+static File open_asset(const char *path, bool accept_gz, bool &gzip)
+{
+  if (accept_gz) {
+    char gz[ASSET_PATH_MAX + 4];
+    snprintf(gz, sizeof(gz), "%s.gz", path);
+    File f = LittleFS.open(gz, "r");
+    if (f) { gzip = true; return f; }
+  }
+  gzip = false;
+  return LittleFS.open(path, "r");
+}
+
+static uint8_t *alloc_asset(size_t n)
+{
+  void *p = psramFound() ? ps_malloc(n) : nullptr;
+  if (!p) p = malloc(n);
+  return (uint8_t *)p;
+}
+
+// 读进缓存槽；文件太大或内存不够返回 nullptr
+static AssetSlot *load(const char *path, bool accept_gz)
+{
+  bool gzip;
+  File f = open_asset(path, accept_gz, gzip);
+  if (!f) return nullptr;
+
+  size_t len = f.size();
+  if (len == 0 || len > ASSET_CACHE_MAX_BYTES) { f.close(); return nullptr; }
+
+  // 先找空槽，没有就轮换淘汰一个没在发送的
+  AssetSlot *slot = nullptr;
+  for (auto &s : g_slots) if (!s.used && s.refs == 0) { slot = &s; break; }
+  for (int i = 0; !slot && i < ASSET_CACHE_SLOTS; i++) {
+    AssetSlot &s = g_slots[g_next_victim];
+    g_next_victim = (g_next_victim + 1) % ASSET_CACHE_SLOTS;
+    if (s.refs == 0) slot = &s;
+  }
+  if (!slot) { f.close(); return nullptr; }
+  if (slot->used) {
+    g_stats.cached_bytes -= slot->len;
+    slot->used = false;
+  }
+
+  // 按 4KB 取整分配，同一个槽换文件时大小差不多就直接复用
+  uint8_t cls = (uint8_t)((len + 4095) / 4096);
+  if (!slot->data || slot->cap_class < cls) {
+    free(slot->data);
+    slot->data = alloc_asset((size_t)cls * 4096);
+    slot->cap_class = slot->data ? cls : 0;
+    if (!slot->data) { f.close(); return nullptr; }
+  }
+
+  size_t got = f.read(slot->data, len);
+  f.close();
+  if (got != len) return nullptr;
+
+  slot->used = true;
+  slot->gzip = gzip;
+  slot->tried_gz = accept_gz;
+  slot->len = len;
+  strncpy(slot->path, path, sizeof(slot->path) - 1);
+  slot->path[sizeof(slot->path) - 1] = '\0';
+  snprintf(slot->etag, sizeof(slot->etag), "\"%08x\"", (unsigned)link_crc32(slot->data, len));
+  g_stats.cached_bytes += len;
+  return slot;
+}
+
+// 大文件的 ETag：查表，没有就分段读一遍算 crc（只在这个文件第一次被请求时发生）
+static const char *stream_etag(const char *path, bool gzip, File &f)
+{
+  for (auto &t : g_tags) {
+    if (t.used && t.gzip == gzip && !strcmp(t.path, path)) return t.etag;
+  }
+
+  static uint8_t buf[512];   // 只在 AsyncTCP 任务里用
+  uint32_t crc = 0;
+  size_t n;
+  while ((n = f.read(buf, sizeof(buf))) > 0) crc = link_crc32(buf, n, crc);
+
+  AssetTag &t = g_tags[g_next_tag];
+  g_next_tag = (g_next_tag + 1) % ASSET_TAG_SLOTS;
+  t.used = true;
+  t.gzip = gzip;
+  strncpy(t.path, path, sizeof(t.path) - 1);
+  t.path[sizeof(t.path) - 1] = '\0';
+  snprintf(t.etag, sizeof(t.etag), "\"%08x\"", (unsigned)crc);
+  return t.etag;
+}
+
+static bool etag_matches(AsyncWebServerRequest *request, const char *etag)
+{
+  if (!request->hasHeader("If-None-Match")) return false;
+  return strstr(request->getHeader("If-None-Match")->value().c_str(), etag) != nullptr;
+}
+
+} // namespace
+
+void web_assets_handle(AsyncWebServerRequest *request)
+{
+  char path[ASSET_PATH_MAX];
+  const char *url = request->url().c_str();
+  if (!strcmp(url, "/")) url = "/index.html";
+  if (strlen(url) >= sizeof(path) || strstr(url, "..")) {
+    request->send(404, "text/plain", "not found");
+    return;
+  }
+  strcpy(path, url);
+
+  uint32_t gen = g_gen.load(std::memory_order_acquire);
+  if (gen != g_seen_gen) {
+    g_seen_gen = gen;
+    for (auto &s : g_slots) s.used = false;   // 内存留着下次复用，还在发送的等 refs 归零
+    for (auto &t : g_tags) t.used = false;
+    g_stats.cached_bytes = 0;
+  }
+
+  bool accept_gz = accepts_gzip(request);
+  AssetSlot *slot = find(path, accept_gz);
+  if (slot) {
+    g_stats.hits++;
+  } else {
+    g_stats.misses++;
+    slot = load(path, accept_gz);
+  }
+
+  if (slot) {
+    if (etag_matches(request, slot->etag)) {
+      g_stats.not_modified++;
+      request->send(304);
+      return;
+    }
+    // 直接从缓存内存发，不复制；连接断开前这块内存不能动
+    slot->refs++;
+    request->onDisconnect([slot]() { slot->refs--; });
+    AsyncWebServerResponse *res = request->beginResponse(200, content_type(path), slot->data, slot->len);
+    if (slot->gzip) res->addHeader("Content-Encoding", "gzip");
+    res->addHeader("Vary", "Accept-Encoding");
+    res->addHeader("ETag", slot->etag);
+    res->addHeader("Cache-Control", "no-cache");   // 每次都带 ETag 来问，没变就 304
+    request->send(res);
+    return;
+  }
+
+  // 不进缓存的大文件：从 flash 流式发送，ETag / 304 规则和缓存的一样
+  bool gzip;
+  File f = open_asset(path, accept_gz, gzip);
+  if (!f) {
+    request->send(404, "text/plain", "not found");
+    return;
+  }
+  const char *etag = stream_etag(path, gzip, f);
+  f.close();
+  if (etag_matches(request, etag)) {
+    g_stats.not_modified++;
+    request->send(304);
+    return;
+  }
+  char real[ASSET_PATH_MAX + 4];
+  snprintf(real, sizeof(real), gzip ? "%s.gz" : "%s", path);
+  AsyncWebServerResponse *res = request->beginResponse(LittleFS, real, content_type(path));
+  if (gzip) res->addHeader("Content-Encoding", "gzip");
+  res->addHeader("Vary", "Accept-Encoding");
+  res->addHeader("ETag", etag);
+  res->addHeader("Cache-Control", "no-cache");
+  request->send(res);
+}
+
+void web_assets_invalidate()
+{
+  g_gen.fetch_add(1, std::memory_order_release);
+}
+
+const AssetStats &web_assets_stats()
+{
+  return g_stats;
+}
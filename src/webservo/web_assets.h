@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+
+/* =========================
+ * 静态资源（LittleFS）
+ * - 请求带 Accept-Encoding: gzip 时优先发构建时压好的 <path>.gz（Content-Encoding: gzip），
+ *   否则发原文件；两种都带 Vary: Accept-Encoding
+ * - 强 ETag = 所发文件内容的 crc32，If-None-Match 命中回 304（大文件也一样）
+ * - 小文件首次读取后常驻内存（有 PSRAM 放 PSRAM），之后不再碰 flash
+ * - 大文件每次从 flash 流式发送，ETag 在第一次请求时算好记下
+ * ========================= */
+#define ASSET_CACHE_SLOTS      4
+#define ASSET_CACHE_MAX_BYTES  (32 * 1024)   // 超过这个大小不进缓存，每次从 flash 流式发送
+#define ASSET_PATH_MAX         48
+#define ASSET_TAG_SLOTS        8             // 大文件 ETag 记几个
+
+struct AssetStats {
+  uint32_t hits;          // 内存命中
+  uint32_t misses;        // 读 flash
+  uint32_t not_modified;  // 回 304
+  uint32_t cached_bytes;
+};
+
+void web_assets_handle(AsyncWebServerRequest *request);   // GET 静态资源
+void web_assets_invalidate();                             // 文件更新后清缓存（任意任务可调）
+const AssetStats &web_assets_stats();
@@ -1,61 +1,182 @@
 #include "ws2812.h"
+#include "ws2812_motion.h"
+#include "../stream/led_rx.h"
+#include <atomic>
+
+// 渲染缓冲（GRB）：效果由 ws2812_render.cpp 画进来，ws2812_out.cpp 经 RMT 推出去
+alignas(4) static uint8_t g_pixels[LED_COUNT * 3];   // 对齐，像素内核才能按字处理
+static bool g_pixels_dirty = false;   // 渲染过、还没推出去
+static bool g_live = false;           // 外部灯光台接管中（stream/led_in.h）
+
+// 每个分区当前的模式（ws2812_mode_t，或 WS2812_MODE_RAINBOW），遥测用
+static uint8_t g_part_mode[WS2812_PART_MAX];
+
+// 默认布局：LittleFS 里没有布局文件时用
+static const ws2812_partition_def_t k_default_layout[WS2812_PART_NAMED] = {
+  { Partition_A_Start, Partition_A_End, true },
+  { Partition_B_Start, Partition_B_End, true },
+  { Partition_C_Start, Partition_C_End, true },
+  { Partition_D_Start, Partition_D_End, true },
+  { Partition_E_Start, Partition_E_End, true },
+};
+
+static std::atomic<bool> g_layout_reload{false};
+
+uint8_t ws2812_part_mode(uint8_t part) {
+  if (part >= ws2812_layout_count()) return WS2812_MODE_INVALID;
+  return g_part_mode[part];
+}
 
-WS2812FX ws2812fx = WS2812FX(LED_COUNT, LED_PIN, NEO_GRB + NEO_KHZ800);
+uint8_t ws2812_part_count() {
+  return ws2812_layout_count();
+}
 
-void ws2812_is_running(){
-      ws2812fx.service();
+// 实际推到灯带的帧数（只有像素变了才推）
+static uint32_t g_frames_pushed = 0;
+
+uint32_t ws2812_frames_pushed() {
+  return g_frames_pushed;
 }
 
-/* =========================
- * 初始化：把每个分区注册成一个 segment
- * 建议在 ws2812fx.init() 之后、start() 之前调用一次
- * ========================= */
-static inline void ws2812_PartitionsInit() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
-    if (!g_parts[i].enabled) continue;
-
-    // 给每个分区一个默认静态关灯/低亮也行，这里默认关
-    ws2812fx.setSegment(
-      (uint8_t)i,
-      (uint16_t)g_parts[i].start,
-      (uint16_t)g_parts[i].end,
-      (uint8_t)FX_MODE_STATIC,
-      (uint32_t)0x000000,
-      (uint16_t)1000,
-      (uint8_t)NO_OPTIONS
-    );
+uint32_t ws2812_frames_rendered() {
+  return ws_render_stats().frames_rendered;
+}
+
+// 全静态（比如待机全绿）时这里只做几次比较，不再每帧重画、重推
+// 推送不阻塞：上一帧还在发就留着脏标记，下一轮推最新画面
+void ws2812_is_running(){
+  uint32_t now = hal_millis();
+  if (g_layout_reload.exchange(false, std::memory_order_acq_rel)) ws2812_load_layout(WS2812_LAYOUT_PATH);
+
+  // 外部实时帧：接收槽位直接推，不经过渲染缓冲
+  if (led_rx_active(now)) {
+    g_live = true;
+    const uint8_t *live = led_rx_peek(now);
+    if (live && !ws_out_busy() && ws_out_show(live, ws2812_power_limit(live, LED_COUNT))) {
+      led_rx_consume(now);
+      g_frames_pushed++;
+    }
+    return;
+  }
+  if (g_live) {               // 交还：分区整段重画
+    g_live = false;
+    ws_render_invalidate();
+    g_pixels_dirty = true;
+  }
+
+  ws2812_motion_service(now);
+  bool drawn = ws_render_frame(now);
+  if (drawn) g_pixels_dirty = true;
+  if (ws2812_clip_service(now, drawn)) g_pixels_dirty = true;   // 片段在分区之后写，盖在上面
+  if (g_pixels_dirty && !ws_out_busy() && ws_out_show(g_pixels, ws2812_power_limit(g_pixels, LED_COUNT))) {
+    g_pixels_dirty = false;
+    g_frames_pushed++;
   }
 }
 
 /* =========================
  * 对外统一 API：改变某个分区为某个模式
  * ========================= */
-static inline bool ws2812_Change(ws2812_partition_t part, ws2812_mode_t mode) {
-  if (part >= WS2812_PART_COUNT) return false;
+static uint16_t g_fade_ms = WS2812_FADE_DEFAULT_MS;
+
+void ws2812_set_fade_ms(uint16_t ms) {
+  g_fade_ms = ms;
+}
+
+// 按当前布局把模式交给渲染器；mode 可以是 g_modes 里的，也可以是 WS2812_MODE_RAINBOW
+static bool part_set(uint8_t part, uint8_t mode, uint16_t fade_ms) {
+  const ws2812_partition_def_t *p = ws2812_layout_part(part);
+  if (!p || !p->enabled) return false;
+
+  if (mode == WS2812_MODE_RAINBOW) {
+    ws_render_set(part, p->start, p->end, WS_FX_RAINBOW_CYCLE, 0, 1200, fade_ms);
+  } else {
+    if (mode >= WS2812_MODE_COUNT) return false;
+    const ws2812_mode_def_t &m = g_modes[mode];
+    ws_render_set(part, p->start, p->end, m.fx_mode, m.color, m.speed, fade_ms);
+  }
+  g_part_mode[part] = mode;
+  return true;
+}
+
+bool ws2812_ChangeFade(ws2812_partition_t part, ws2812_mode_t mode, uint16_t fade_ms) {
   if (mode >= WS2812_MODE_COUNT) return false;
-  if (!g_parts[part].enabled)    return false;
+  return part_set((uint8_t)part, (uint8_t)mode, fade_ms);
+}
 
-  const ws2812_partition_def_t &p = g_parts[part];
-  const ws2812_mode_def_t &m = g_modes[mode];
+/* =========================
+ * 布局
+ * 换布局后每个分区按原来的模式重新设一遍（新增的分区默认关），
+ * 多出来的渲染槽停用；像素缓冲清零后整体重画，不属于任何分区的灯就灭了
+ * ========================= */
+bool ws2812_set_layout(const ws2812_partition_def_t *parts, uint8_t n, char *err, size_t cap) {
+  uint8_t old_n = ws2812_layout_count();
+  if (!ws2812_layout_apply(parts, n, LED_COUNT, err, cap)) return false;
+
+  ws2812_clip_stop();   // 片段暂停的是旧布局的分区
+
+  for (uint8_t i = 0; i < WS2812_PART_MAX; i++) {
+    if (i >= old_n) g_part_mode[i] = WS2812_MODE_OFF;
+    if (i >= n || !parts[i].enabled) {
+      ws_render_disable(i);
+      continue;
+    }
+    part_set(i, g_part_mode[i], 0);
+  }
+  memset(g_pixels, 0, sizeof(g_pixels));
+  ws_render_invalidate();
+  g_pixels_dirty = true;
+  return true;
+}
 
-  ws2812fx.setSegment(
-    (uint8_t)part,
-    p.start,
-    p.end,
-    m.fx_mode,
-    m.color,
-    m.speed,
-    m.options
-  );
+bool ws2812_load_layout(const char *path) {
+  HalFile f = hal_fs_open(path);
+  if (f < 0) return false;
+
+  static char text[WS2812_LAYOUT_FILE_MAX];
+  bool truncated = hal_fs_size(f) > sizeof(text);
+  size_t len = truncated ? 0 : hal_fs_read(f, (uint8_t *)text, sizeof(text));
+  hal_fs_close(f);
+  if (truncated) {
+    hal_log("ws2812 layout %s: larger than %u bytes\n", path, (unsigned)WS2812_LAYOUT_FILE_MAX);
+    return false;
+  }
 
+  ws2812_partition_def_t parts[WS2812_PART_MAX];
+  char err[64];
+  int n = ws2812_layout_parse(text, len, parts, WS2812_PART_MAX, err, sizeof(err));
+  if (n <= 0 || !ws2812_set_layout(parts, (uint8_t)n, err, sizeof(err))) {
+    hal_log("ws2812 layout %s rejected: %s\n", path, n == 0 ? "empty" : err);
+    return false;
+  }
+  hal_log("ws2812 layout %s: %d partitions\n", path, n);
   return true;
 }
 
+void ws2812_layout_request_reload() {
+  g_layout_reload.store(true, std::memory_order_release);
+}
+
+// 业务里的切换统一带默认过渡
+static inline bool ws2812_Change(ws2812_partition_t part, ws2812_mode_t mode) {
+  return ws2812_ChangeFade(part, mode, g_fade_ms);
+}
+
 void ws2812_init(){
-    ws2812fx.init();
-    ws2812fx.setBrightness(100);
-    ws2812_PartitionsInit();
-    ws2812fx.start();
+    if (!ws_out_init(k_ws2812_strips, WS2812_STRIP_COUNT)) {
+      hal_log("ws2812 rmt init failed\n");
+    }
+    ws2812_power_init();
+    ws_render_init(g_pixels, LED_COUNT);
+    ws2812_clip_init(g_pixels, LED_COUNT);
+    ws_render_brightness(100);
+
+    // 先装默认布局，文件里有合法布局再换掉
+    char err[64];
+    if (!ws2812_set_layout(k_default_layout, WS2812_PART_NAMED, err, sizeof(err))) {
+      hal_log("ws2812 default layout invalid: %s\n", err);
+    }
+    if (hal_fs_begin()) ws2812_load_layout(WS2812_LAYOUT_PATH);
 }
 
 
@@ -78,75 +199,75 @@ void ws2812_part_off(ws2812_partition_t part)
 /*控制区*/
 /*全常亮*/
 void ws2812_staute_green() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_GREEN_SOLID);
   }
 }
 
 void ws2812_staute_yello() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_YELLOW_SOLID);
   }
 }
 
 void ws2812_staute_red() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_RED_SOLID);
   }
 }
 
 /*全闪*/
 void ws2812_all_blink_red() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_RED_BLINK);
   }
 }
 
 void ws2812_all_blink_yellow() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_YELLOW_BLINK);
   }
 }
 
 void ws2812_all_blink_green() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_GREEN_BLINK);
   }
 }
 
 /*全呼吸*/
 void ws2812_all_breath_red() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_RED_BREATH);
   }
 }
 
 void ws2812_all_breath_yellow() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_YELLOW_BREATH);
   }
 }
 
 void ws2812_all_breath_green() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_GREEN_BREATH);
   }
 }
 /*全流水*/
 void ws2812_all_flow_red() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_RED_FLOW);
   }
 }
 
 void ws2812_all_flow_yellow() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_YELLOW_FLOW);
   }
 }
 
 void ws2812_all_flow_green() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
     ws2812_Change((ws2812_partition_t)i, WS2812_MODE_GREEN_FLOW);
   }
 }
@@ -178,18 +299,8 @@ void ws2812_scan_sig_worning_end(){
 
 
 void ws2812_err_2() {
-  for (uint8_t i = 0; i < WS2812_PART_COUNT; i++) {
-    if (!g_parts[i].enabled) continue;
-
-    ws2812fx.setSegment(
-        (uint8_t)i,
-        (uint16_t)g_parts[i].start,
-        (uint16_t)g_parts[i].end,
-        (uint8_t)FX_MODE_RAINBOW_CYCLE,
-        (uint32_t)0,
-        (uint16_t)1200,
-        (uint8_t)NO_OPTIONS
-    );
+  for (uint8_t i = 0; i < ws2812_part_count(); i++) {
+    part_set(i, WS2812_MODE_RAINBOW, g_fade_ms);
   }
 }
 
@@ -1,18 +1,40 @@
 #ifndef __ws2812_h__
 #define __ws2812_h__
 
-#include <WS2812FX.h>
+#include "../hal/hal.h"
+#include "ws2812_modes.h"
+#include "ws2812_render.h"
+#include "ws2812_out.h"
+#include "ws2812_power.h"
+#include "ws2812_layout.h"
+#include "ws2812_clip_player.h"
 
 #define LED_COUNT 50
 #define LED_PIN 35
 
+/* =========================
+ * 物理灯带表：把 0..LED_COUNT-1 这条逻辑灯带切成几段，每段一个引脚、一个 RMT 通道并行发送
+ * 分区只按逻辑下标划分，可以跨灯带。灯多了就按段拆开，帧率随路数线性提升
+ * （最多 WS_OUT_MAX_STRIPS 路，合计不超过 WS_OUT_MAX_LEDS）
+ * ========================= */
+#define WS2812_STRIP_COUNT 1
+static const WsOutStrip k_ws2812_strips[WS2812_STRIP_COUNT] = {
+  { LED_PIN, 0, LED_COUNT },
+};
+
+// 分区换模式时的默认过渡时间（0 = 直接切）
+#define WS2812_FADE_DEFAULT_MS 300
+
+// 开机从这里加载分区布局（格式见 ws2812_layout.h），没有或不合法就用下面的默认布局
+#define WS2812_LAYOUT_PATH     "/led_layout.txt"
+#define WS2812_LAYOUT_FILE_MAX 512
+
 
 
 
 /* =========================
- * 分区范围（你已有）
- * 注意：WS2812FX 灯珠下标通常是 0..LED_COUNT-1
- * 你这里从 1 开始没问题，但要确保你物理/逻辑一致
+ * 默认布局的分区范围
+ * 注意：灯珠下标是 0..LED_COUNT-1，end 为闭区间
  * ========================= */
 #define Partition_A_Start 0
 #define Partition_A_End   10
@@ -23,10 +45,13 @@
 #define Partition_D_Start 31
 #define Partition_D_End   40
 #define Partition_E_Start 41
-#define Partition_E_End   50
+#define Partition_E_End   (LED_COUNT - 1)
+
+static_assert(LED_COUNT <= WS2812_LAYOUT_MAX_LEDS, "LED_COUNT exceeds layout capacity");
 
 /* =========================
- * 分区 ID（可扩展：新增分区就在这里加）
+ * 默认布局的分区 ID（业务预设按名字用；运行时布局可以更多或更少，
+ * 不存在的分区 ws2812_Change 直接返回 false）
  * ========================= */
 typedef enum {
   WS2812_PART_A = 0,
@@ -35,89 +60,24 @@ typedef enum {
   WS2812_PART_D,
   WS2812_PART_E,
 
-  WS2812_PART_COUNT,   // 分区数量
+  WS2812_PART_NAMED,   // 默认布局的分区数
   WS2812_PART_INVALID = 0xFF
 } ws2812_partition_t;
 
-typedef struct {
-  uint16_t start;
-  uint16_t end;
-  bool     enabled;
-} ws2812_partition_def_t;
-
-/* =========================
- * 分区表（可扩展：新增分区就加一行）
- * ========================= */
-static ws2812_partition_def_t g_parts[WS2812_PART_COUNT] = {
-  { Partition_A_Start, Partition_A_End, true },
-  { Partition_B_Start, Partition_B_End, true },
-  { Partition_C_Start, Partition_C_End, true },
-  { Partition_D_Start, Partition_D_End, true },
-  { Partition_E_Start, Partition_E_End, true },
-};
-
-/* =========================
- * 模式（12种：红黄绿 × 呼吸/常亮/流水/闪烁）
- * ========================= */
-typedef enum {
-  WS2812_MODE_RED_BREATH = 0,
-  WS2812_MODE_RED_SOLID,
-  WS2812_MODE_RED_FLOW,
-  WS2812_MODE_RED_BLINK,
-
-  WS2812_MODE_YELLOW_BREATH,
-  WS2812_MODE_YELLOW_SOLID,
-  WS2812_MODE_YELLOW_FLOW,
-  WS2812_MODE_YELLOW_BLINK,
-
-  WS2812_MODE_GREEN_BREATH,
-  WS2812_MODE_GREEN_SOLID,
-  WS2812_MODE_GREEN_FLOW,
-  WS2812_MODE_GREEN_BLINK,
-
-  WS2812_MODE_OFF,
-  WS2812_MODE_COUNT,
-  WS2812_MODE_INVALID = 0xFF
-} ws2812_mode_t;
-
-typedef struct {
-  uint8_t  fx_mode;     // WS2812FX 的 FX_MODE_*
-  uint32_t color;       // 0xRRGGBB
-  uint16_t speed;       // WS2812FX speed
-  uint8_t  options;     // NO_OPTIONS 等
-} ws2812_mode_def_t;
-
-/* =========================
- * 模式表（你要改速度/效果，只改这里）
- * ========================= */
-static const ws2812_mode_def_t g_modes[WS2812_MODE_COUNT] = {
-  // RED
-  { FX_MODE_BREATH,         0xFF0000, 200, NO_OPTIONS }, // RED_BREATH
-  { FX_MODE_STATIC,         0xFF0000, 1000, NO_OPTIONS }, // RED_SOLID
-  { FX_MODE_RUNNING_LIGHTS, 0xFF0000,  900, NO_OPTIONS }, // RED_FLOW
-  { FX_MODE_BLINK,          0xFF0000,  500, NO_OPTIONS }, // RED_BLINK
-
-  // YELLOW
-  { FX_MODE_BREATH,         0xFFFF00, 200, NO_OPTIONS }, // YELLOW_BREATH
-  { FX_MODE_STATIC,         0xFFFF00, 1000, NO_OPTIONS }, // YELLOW_SOLID
-  { FX_MODE_RUNNING_LIGHTS, 0xFFFF00,  900, NO_OPTIONS }, // YELLOW_FLOW
-  { FX_MODE_BLINK,          0xFFFF00,  500, NO_OPTIONS }, // YELLOW_BLINK
-
-  // GREEN
-  { FX_MODE_BREATH,         0x00FF00, 200, NO_OPTIONS }, // GREEN_BREATH
-  { FX_MODE_STATIC,         0x00FF00, 1000, NO_OPTIONS }, // GREEN_SOLID
-  { FX_MODE_RUNNING_LIGHTS, 0x00FF00,  900, NO_OPTIONS }, // GREEN_FLOW
-  { FX_MODE_BLINK,          0x00FF00,  500, NO_OPTIONS }, // GREEN_BLINK
-
-  { FX_MODE_STATIC, 0x000000, 1000, NO_OPTIONS }, // OFF
-};
-
-
-
-
 void ws2812_init();
 void ws2812_is_running();
 void ws2812_Change();
+bool ws2812_ChangeFade(ws2812_partition_t part, ws2812_mode_t mode, uint16_t fade_ms);  // 带过渡地换模式
+void ws2812_set_fade_ms(uint16_t ms);     // 改默认过渡时间（ws2812_Change 和各预设用）
+uint8_t ws2812_part_mode(uint8_t part);   // 分区当前模式
+uint8_t ws2812_part_count();              // 当前布局的分区数
+
+// 换布局：校验通过才生效，各分区保持原来的模式；失败 err 里是原因
+bool ws2812_set_layout(const ws2812_partition_def_t *parts, uint8_t n, char *err, size_t cap);
+bool ws2812_load_layout(const char *path);   // 从 LittleFS 读文本布局并生效
+void ws2812_layout_request_reload();         // 任意任务可调：下一轮 loop 重新加载 WS2812_LAYOUT_PATH
+uint32_t ws2812_frames_pushed();          // 累计推送帧数（像素有变化才推）
+uint32_t ws2812_frames_rendered();        // 累计渲染帧数（至少重画了一个分区）
 //***********业务区**************
 void ws2812_demo1();
 void ws2812_scan_sig();
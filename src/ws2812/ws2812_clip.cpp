@@ -0,0 +1,75 @@
+#include "ws2812_clip.h"
+
+#include <string.h>
+
+namespace {
+
+static inline uint16_t get_u16(const uint8_t *p)
+{
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// 写一个元素：有调色板查表，没有直接拷 3 字节
+static inline bool put_elem(const WsClipHeader &h, const uint8_t *pal, const uint8_t *e, uint8_t *dst)
+{
+  if (h.palette_len) {
+    if (*e >= h.palette_len) return false;
+    memcpy(dst, &pal[*e * 3], 3);
+  } else {
+    memcpy(dst, e, 3);
+  }
+  return true;
+}
+
+} // namespace
+
+bool ws_clip_parse_header(const uint8_t *p, size_t n, WsClipHeader &h)
+{
+  if (n < WS_CLIP_HEADER_LEN) return false;
+  if (memcmp(p, WS_CLIP_MAGIC, 4) != 0 || p[4] != WS_CLIP_VERSION) return false;
+
+  h.flags = p[5];
+  h.fps = p[6];
+  h.palette_len = (h.flags & WS_CLIP_F_PALETTE) ? (p[7] ? p[7] : 256) : 0;
+  h.first = get_u16(&p[8]);
+  h.width = get_u16(&p[10]);
+  h.frames = get_u16(&p[12]);
+  return h.fps > 0 && h.fps <= WS_CLIP_MAX_FPS && h.width > 0 && h.frames > 0;
+}
+
+size_t ws_clip_palette_bytes(const WsClipHeader &h)
+{
+  return (size_t)h.palette_len * 3;
+}
+
+bool ws_clip_decode(const WsClipHeader &h, const uint8_t *pal,
+                    const uint8_t *payload, size_t len, uint8_t *grb)
+{
+  const size_t esz = h.palette_len ? 1 : 3;
+
+  if (!(h.flags & WS_CLIP_F_RLE)) {
+    if (len != (size_t)h.width * esz) return false;
+    if (!h.palette_len) {
+      memcpy(grb, payload, len);    // 最常见的情况：整帧一次拷贝
+      return true;
+    }
+    for (uint16_t i = 0; i < h.width; i++) {
+      if (!put_elem(h, pal, &payload[i], &grb[i * 3])) return false;
+    }
+    return true;
+  }
+
+  const uint8_t *p = payload;
+  const uint8_t *end = payload + len;
+  uint16_t px = 0;
+  while (p < end) {
+    if ((size_t)(end - p) < 1 + esz) return false;
+    uint8_t run = *p++;
+    if (run == 0 || px + run > h.width) return false;
+    if (!put_elem(h, pal, p, &grb[px * 3])) return false;
+    for (uint8_t k = 1; k < run; k++) memcpy(&grb[(px + k) * 3], &grb[px * 3], 3);
+    px += run;
+    p += esz;
+  }
+  return px == h.width;
+}
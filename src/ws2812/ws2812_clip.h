@@ -0,0 +1,59 @@
+#pragma once
+
+/* =========================
+ * 预烘焙灯效片段：格式与解码（不依赖 Arduino，烘焙工具和固件共用）
+ *
+ * 片段是一串算好的帧，播放时只是把帧拷进渲染缓冲，不再逐灯做效果运算。
+ * 像素已经是 LED 最终值（GRB，gamma 在烘焙时做过），可选调色板和游程压缩。
+ *
+ * 文件布局（小端）：
+ *   头 16 字节：
+ *     [0..3]   "WSCL"
+ *     [4]      版本 WS_CLIP_VERSION
+ *     [5]      标志 WS_CLIP_F_*
+ *     [6]      帧率（1..100）
+ *     [7]      调色板项数（有 PALETTE 标志时有效，0 = 256）
+ *     [8..9]   起始灯号（写到渲染缓冲的哪里）
+ *     [10..11] 宽度（灯数）
+ *     [12..13] 帧数
+ *     [14..15] 保留 0
+ *   调色板：项数 × 3 字节 GRB（有 PALETTE 标志时）
+ *   帧：uint16 负载长度 + 负载
+ *     不压缩：宽度 × 元素
+ *     RLE：若干 (次数 1..255, 元素)，展开后正好宽度个
+ *   元素：有调色板时 1 字节索引，否则 3 字节 GRB
+ * ========================= */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define WS_CLIP_MAGIC        "WSCL"
+#define WS_CLIP_VERSION      1
+#define WS_CLIP_HEADER_LEN   16
+#define WS_CLIP_MAX_FPS      100
+
+enum : uint8_t {
+  WS_CLIP_F_PALETTE = 0x01,
+  WS_CLIP_F_RLE     = 0x02,
+  WS_CLIP_F_LOOP    = 0x04,   // 播完从头再来，直到被停掉
+};
+
+struct WsClipHeader {
+  uint8_t  flags;
+  uint8_t  fps;
+  uint16_t palette_len;   // 实际项数（1..256），没有调色板为 0
+  uint16_t first;
+  uint16_t width;
+  uint16_t frames;
+};
+
+// 解析头；格式不对返回 false
+bool ws_clip_parse_header(const uint8_t *p, size_t n, WsClipHeader &h);
+
+// 调色板占的字节数（紧跟在头后面）
+size_t ws_clip_palette_bytes(const WsClipHeader &h);
+
+// 解码一帧到 grb（宽度 × 3 字节）；pal 为 GRB 调色板（没有调色板可为 nullptr）
+// 负载长度和宽度对不上、索引超出调色板都返回 false，grb 内容不保证
+bool ws_clip_decode(const WsClipHeader &h, const uint8_t *pal,
+                    const uint8_t *payload, size_t len, uint8_t *grb);
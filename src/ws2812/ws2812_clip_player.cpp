@@ -0,0 +1,205 @@
+#include "ws2812_clip_player.h"
+#include "ws2812_layout.h"
+#include "ws2812_render.h"
+#include "ws2812_px.h"
+
+namespace {
+
+// 数据来源：文件或内存，读法一样
+struct ClipSrc {
+  HalFile        f = HAL_FILE_NONE;
+  const uint8_t *mem = nullptr;
+  size_t         mem_len = 0;
+  size_t         pos = 0;
+
+  size_t read(uint8_t *dst, size_t n) {
+    if (!mem) return hal_fs_read(f, dst, n);
+    if (pos + n > mem_len) n = mem_len - pos;
+    memcpy(dst, mem + pos, n);
+    pos += n;
+    return n;
+  }
+  bool seek(size_t to) {
+    if (!mem) return hal_fs_seek(f, to);
+    if (to > mem_len) return false;
+    pos = to;
+    return true;
+  }
+  void close() {
+    if (!mem) hal_fs_close(f);
+    f = HAL_FILE_NONE;
+    mem = nullptr;
+  }
+};
+
+static uint8_t  *g_pix = nullptr;
+static uint16_t  g_count = 0;
+
+static ClipSrc      g_src;
+static WsClipHeader g_hdr;
+static uint8_t      g_pal[256 * 3];
+static uint8_t      g_frame[WS2812_CLIP_FRAME_MAX];
+static uint8_t      g_px[WS2812_CLIP_MAX_LEDS * 3];   // 当前帧解码后的像素（没乘亮度）
+static bool         g_have_px = false;
+static uint8_t      g_px_bri = 0;       // 上次写进缓冲时用的全局亮度
+static size_t       g_data_pos = 0;     // 第 0 帧在源里的位置
+static uint16_t     g_next = 0;         // 下一个要读的帧号
+static uint32_t     g_t0_ms = 0;        // 第 0 帧的时间
+static bool         g_held[WS2812_PART_MAX];
+static Ws2812ClipStats g_stats = {};
+
+static void hold_parts(bool on)
+{
+  for (uint8_t i = 0; i < WS2812_PART_MAX; i++) {
+    if (g_held[i]) ws_render_hold(i, on);
+    if (!on) g_held[i] = false;
+  }
+}
+
+static bool fail(const char *why)
+{
+  hal_log("ws2812 clip: %s\n", why);
+  g_stats.errors++;
+  if (g_stats.active) ws2812_clip_stop();
+  else                g_src.close();
+  return false;
+}
+
+// 源已打开：读头和调色板，暂停覆盖到的分区
+static bool begin(uint32_t now_ms)
+{
+  uint8_t hdr[WS_CLIP_HEADER_LEN];
+  if (g_src.read(hdr, sizeof(hdr)) != sizeof(hdr) || !ws_clip_parse_header(hdr, sizeof(hdr), g_hdr)) {
+    return fail("bad header");
+  }
+  if ((uint32_t)g_hdr.first + g_hdr.width > g_count) return fail("clip past end of strip");
+  if (g_hdr.width > WS2812_CLIP_MAX_LEDS) return fail("clip too wide");
+
+  size_t pal_bytes = ws_clip_palette_bytes(g_hdr);
+  if (pal_bytes && g_src.read(g_pal, pal_bytes) != pal_bytes) return fail("short palette");
+
+  g_data_pos = WS_CLIP_HEADER_LEN + pal_bytes;
+  g_next = 0;
+  g_t0_ms = now_ms;
+  g_have_px = false;
+  g_stats.active = true;
+  g_stats.started++;
+
+  // 只停整段都在片段里的分区；盖住一部分的照常画，片段每圈补写自己那段
+  uint16_t end = (uint16_t)(g_hdr.first + g_hdr.width);   // 开区间
+  for (uint8_t i = 0; i < WS2812_PART_MAX; i++) {
+    const ws2812_partition_def_t *d = ws2812_layout_part(i);
+    if (d && d->start >= g_hdr.first && d->end < end) g_held[i] = true;
+  }
+  hold_parts(true);
+  return true;
+}
+
+// 解码好的帧乘全局亮度写进缓冲；返回 true = 缓冲变了
+static bool blit()
+{
+  uint8_t bri = ws_render_brightness_get();
+  uint8_t *p = &g_pix[g_hdr.first * 3];
+  size_t n = (size_t)g_hdr.width * 3;
+  alignas(4) static uint8_t out[WS2812_CLIP_MAX_LEDS * 3];   // 只在 loopTask 里用
+  ws_px_scale(out, g_px, n, bri);
+  g_px_bri = bri;
+  if (memcmp(p, out, n) == 0) return false;
+  memcpy(p, out, n);
+  return true;
+}
+
+// 读下一帧的长度；skip = 只跳过不读负载
+static bool read_frame(bool skip, uint16_t &len)
+{
+  uint8_t lb[2];
+  if (g_src.read(lb, 2) != 2) return false;
+  len = (uint16_t)(lb[0] | (lb[1] << 8));
+  if (skip) return g_src.seek(g_src.mem ? g_src.pos + len : hal_fs_tell(g_src.f) + len);
+  if (len > WS2812_CLIP_FRAME_MAX) return false;
+  return g_src.read(g_frame, len) == len;
+}
+
+} // namespace
+
+void ws2812_clip_init(uint8_t *pixels, uint16_t count)
+{
+  g_pix = pixels;
+  g_count = count;
+}
+
+bool ws2812_clip_play(const char *path)
+{
+  ws2812_clip_stop();
+  g_src.f = hal_fs_open(path);
+  g_src.mem = nullptr;
+  if (g_src.f < 0) {
+    g_stats.errors++;
+    hal_log("ws2812 clip: %s not found\n", path);
+    return false;
+  }
+  return begin(hal_millis());
+}
+
+bool ws2812_clip_play_mem(const uint8_t *data, size_t len)
+{
+  ws2812_clip_stop();
+  g_src.mem = data;
+  g_src.mem_len = len;
+  g_src.pos = 0;
+  return begin(hal_millis());
+}
+
+void ws2812_clip_stop()
+{
+  if (!g_stats.active) return;
+  g_stats.active = false;
+  g_src.close();
+  if (g_pix) memset(&g_pix[g_hdr.first * 3], 0, (size_t)g_hdr.width * 3);
+  hold_parts(false);
+  ws_render_invalidate();   // 盖住一部分的分区也要整段重画，补上清掉的灯
+}
+
+bool ws2812_clip_service(uint32_t now_ms, bool under_changed)
+{
+  if (!g_stats.active || !g_pix) return false;
+
+  // 现在该播第几帧；不到点时只在底下被重画过 / 亮度变了时把当前帧补写回去
+  uint32_t due = (uint32_t)((uint64_t)(now_ms - g_t0_ms) * g_hdr.fps / 1000);
+  if (due < g_next) {
+    if (!g_have_px || (!under_changed && g_px_bri == ws_render_brightness_get())) return false;
+    return blit();
+  }
+
+  if (due >= g_hdr.frames) {
+    if (!(g_hdr.flags & WS_CLIP_F_LOOP)) {
+      ws2812_clip_stop();
+      return true;
+    }
+    if (!g_src.seek(g_data_pos)) return fail("seek failed");
+    g_stats.loops++;
+    g_t0_ms = now_ms;
+    g_next = 0;
+    due = 0;
+  }
+
+  uint16_t len;
+  while (g_next < due) {
+    if (!read_frame(true, len)) return fail("truncated frame");
+    g_next++;
+    g_stats.skipped++;
+  }
+  if (!read_frame(false, len)) return fail("truncated or oversize frame");
+  g_next++;
+
+  if (!ws_clip_decode(g_hdr, g_pal, g_frame, len, g_px)) return fail("corrupt frame");
+  g_have_px = true;
+  g_stats.frames++;
+  blit();
+  return true;
+}
+
+const Ws2812ClipStats &ws2812_clip_stats()
+{
+  return g_stats;
+}
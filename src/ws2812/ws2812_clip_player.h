@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../hal/hal.h"
+#include "ws2812_clip.h"
+
+/* =========================
+ * 片段播放器：从 LittleFS 或固件里的常量数组按帧率把片段推进渲染缓冲
+ *
+ * 内存是一帧负载 + 一帧解码后的像素 + 调色板（静态），文件边播边读。
+ * 播放期间被片段整段盖住的分区暂停绘制（ws_render_hold）；只盖住一部分的分区照常画，
+ * 片段每次在分区之后把自己那段重新写上去，分区里片段没盖到的灯照常动。
+ * 片段像素烘焙时已经过 gamma，写进缓冲时和分区效果一样乘全局亮度（ws_render_brightness）。
+ * 片段结束后这段清黑、所有分区整段重画。
+ * 落后超过一帧时直接跳到该播的那帧，不补播。
+ * 同一时间只放一个片段，新的直接顶掉旧的。
+ * ========================= */
+#define WS2812_CLIP_FRAME_MAX 1024   // 单帧负载上限（50 灯不压缩 150 字节）
+#define WS2812_CLIP_MAX_LEDS  300    // 片段宽度上限（解码缓冲）
+
+struct Ws2812ClipStats {
+  uint32_t started;       // 开始播放的次数
+  uint32_t frames;        // 写进缓冲的帧
+  uint32_t skipped;       // 落后跳过的帧
+  uint32_t loops;         // 循环回到开头的次数
+  uint32_t errors;        // 打不开 / 格式错 / 帧太大，放弃播放
+  bool     active;
+};
+
+void ws2812_clip_init(uint8_t *pixels, uint16_t count);
+bool ws2812_clip_play(const char *path);                          // LittleFS 路径
+bool ws2812_clip_play_mem(const uint8_t *data, size_t len);       // 固件里的常量数组
+void ws2812_clip_stop();
+// 每次 loop，在 ws_render_frame 之后；under_changed = 分区这一圈画过东西（可能盖掉了片段那段）
+// 返回 true = 像素缓冲变了
+bool ws2812_clip_service(uint32_t now_ms, bool under_changed);
+const Ws2812ClipStats &ws2812_clip_stats();
@@ -0,0 +1,143 @@
+#include "ws2812_layout.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+static ws2812_partition_def_t g_layout[WS2812_PART_MAX];
+static uint8_t  g_count = 0;
+static uint8_t  g_owner[WS2812_LAYOUT_MAX_LEDS];
+static uint16_t g_led_count = 0;
+
+static void set_err(char *err, size_t cap, const char *fmt, unsigned a, unsigned b = 0, unsigned c = 0)
+{
+  if (err && cap) snprintf(err, cap, fmt, a, b, c);
+}
+
+// 行内取一个无符号十进制数，跳过前面的空白；没有数字返回 false
+static bool next_uint(const char *&p, const char *end, uint32_t &v)
+{
+  while (p < end && (*p == ' ' || *p == '\t')) p++;
+  if (p >= end || *p < '0' || *p > '9') return false;
+  v = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    v = v * 10 + (uint32_t)(*p - '0');
+    if (v > 0xFFFF) return false;
+    p++;
+  }
+  return true;
+}
+
+} // namespace
+
+bool ws2812_layout_validate(const ws2812_partition_def_t *parts, uint8_t n, uint16_t led_count,
+                            char *err, size_t cap)
+{
+  if (n == 0 || n > WS2812_PART_MAX) {
+    set_err(err, cap, "partition count %u out of 1..%u", n, WS2812_PART_MAX);
+    return false;
+  }
+  if (led_count == 0 || led_count > WS2812_LAYOUT_MAX_LEDS) {
+    set_err(err, cap, "led count %u out of 1..%u", led_count, WS2812_LAYOUT_MAX_LEDS);
+    return false;
+  }
+
+  // 分区最多十几个，按起点插入排序后只比相邻的
+  uint8_t order[WS2812_PART_MAX];
+  uint8_t m = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    const ws2812_partition_def_t &p = parts[i];
+    if (!p.enabled) continue;
+    if (p.start > p.end) {
+      set_err(err, cap, "part %u: start %u > end %u", i, p.start, p.end);
+      return false;
+    }
+    if (p.end >= led_count) {
+      set_err(err, cap, "part %u: end %u past last led %u", i, p.end, led_count - 1);
+      return false;
+    }
+    uint8_t k = m++;
+    while (k > 0 && parts[order[k - 1]].start > p.start) { order[k] = order[k - 1]; k--; }
+    order[k] = i;
+  }
+  for (uint8_t k = 1; k < m; k++) {
+    const ws2812_partition_def_t &a = parts[order[k - 1]];
+    const ws2812_partition_def_t &b = parts[order[k]];
+    if (b.start <= a.end) {
+      set_err(err, cap, "part %u overlaps part %u at led %u", order[k], order[k - 1], b.start);
+      return false;
+    }
+  }
+  return true;
+}
+
+int ws2812_layout_parse(const char *text, size_t len, ws2812_partition_def_t *out, uint8_t max,
+                        char *err, size_t cap)
+{
+  const char *p = text;
+  const char *end = text + len;
+  int n = 0;
+  unsigned line = 0;
+
+  while (p < end) {
+    const char *eol = (const char *)memchr(p, '\n', (size_t)(end - p));
+    if (!eol) eol = end;
+    line++;
+
+    const char *q = p;
+    while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+    if (q < eol && *q != '#') {
+      uint32_t s, e, en = 1;
+      if (!next_uint(q, eol, s) || !next_uint(q, eol, e)) {
+        set_err(err, cap, "line %u: expected \"start end [enabled]\"", line);
+        return -1;
+      }
+      next_uint(q, eol, en);
+      while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+      if (q < eol && *q != '#') {
+        set_err(err, cap, "line %u: trailing garbage", line);
+        return -1;
+      }
+      if (n >= max) {
+        set_err(err, cap, "line %u: more than %u partitions", line, max);
+        return -1;
+      }
+      out[n++] = ws2812_partition_def_t{ (uint16_t)s, (uint16_t)e, en != 0 };
+    }
+    p = eol + 1;
+  }
+  return n;
+}
+
+bool ws2812_layout_apply(const ws2812_partition_def_t *parts, uint8_t n, uint16_t led_count,
+                         char *err, size_t cap)
+{
+  if (!ws2812_layout_validate(parts, n, led_count, err, cap)) return false;
+
+  memcpy(g_layout, parts, n * sizeof(parts[0]));
+  g_count = n;
+  g_led_count = led_count;
+
+  memset(g_owner, WS2812_PART_NONE, sizeof(g_owner));
+  for (uint8_t i = 0; i < n; i++) {
+    if (!parts[i].enabled) continue;
+    memset(&g_owner[parts[i].start], i, parts[i].end - parts[i].start + 1);
+  }
+  return true;
+}
+
+uint8_t ws2812_layout_count()
+{
+  return g_count;
+}
+
+const ws2812_partition_def_t *ws2812_layout_part(uint8_t part)
+{
+  return (part < g_count) ? &g_layout[part] : nullptr;
+}
+
+uint8_t ws2812_layout_owner(uint16_t pixel)
+{
+  return (pixel < g_led_count) ? g_owner[pixel] : WS2812_PART_NONE;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+/* =========================
+ * 分区布局（运行时可改，不依赖 Arduino）
+ *
+ * 全模块只有这一份分区表：ws2812.cpp 开机装默认布局，之后可以从 LittleFS 换掉。
+ * 换布局前整体校验（范围、越界、重叠），不通过就保留原来的，不会装一半。
+ * 分区号 -> 灯珠范围直接按下标取；灯珠 -> 分区有一张反查表，也是 O(1)。
+ *
+ * 文本格式（一行一个分区，行号就是分区号，# 开头是注释）：
+ *   start end [enabled]      end 为闭区间；enabled 省略为 1
+ * ========================= */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ws2812_render.h"
+
+#define WS2812_PART_MAX         WS_RENDER_MAX_PARTS   // 布局最多这么多分区
+#define WS2812_LAYOUT_MAX_LEDS  1200                  // 反查表容量
+#define WS2812_PART_NONE        0xFF                  // 灯珠不属于任何分区
+
+typedef struct {
+  uint16_t start;
+  uint16_t end;       // 闭区间
+  bool     enabled;
+} ws2812_partition_def_t;
+
+// 校验一张表；失败时 err 里写原因（可为 nullptr）
+bool ws2812_layout_validate(const ws2812_partition_def_t *parts, uint8_t n, uint16_t led_count,
+                            char *err, size_t cap);
+
+// 解析文本布局；返回分区数，格式错返回 -1（只解析，不校验范围）
+int ws2812_layout_parse(const char *text, size_t len, ws2812_partition_def_t *out, uint8_t max,
+                        char *err, size_t cap);
+
+// 校验通过才替换当前布局并重建反查表
+bool ws2812_layout_apply(const ws2812_partition_def_t *parts, uint8_t n, uint16_t led_count,
+                         char *err, size_t cap);
+
+uint8_t ws2812_layout_count();
+const ws2812_partition_def_t *ws2812_layout_part(uint8_t part);   // 越界返回 nullptr
+uint8_t ws2812_layout_owner(uint16_t pixel);                       // 灯珠所属分区，WS2812_PART_NONE = 没有
@@ -0,0 +1,61 @@
+#pragma once
+
+// 模式表单独放：固件和主机基准（tools/led_bench）共用，不依赖 Arduino
+#include <stdint.h>
+#include "ws2812_render.h"
+
+/* =========================
+ * 模式（12种：红黄绿 × 呼吸/常亮/流水/闪烁）
+ * ========================= */
+typedef enum {
+  WS2812_MODE_RED_BREATH = 0,
+  WS2812_MODE_RED_SOLID,
+  WS2812_MODE_RED_FLOW,
+  WS2812_MODE_RED_BLINK,
+
+  WS2812_MODE_YELLOW_BREATH,
+  WS2812_MODE_YELLOW_SOLID,
+  WS2812_MODE_YELLOW_FLOW,
+  WS2812_MODE_YELLOW_BLINK,
+
+  WS2812_MODE_GREEN_BREATH,
+  WS2812_MODE_GREEN_SOLID,
+  WS2812_MODE_GREEN_FLOW,
+  WS2812_MODE_GREEN_BLINK,
+
+  WS2812_MODE_OFF,
+  WS2812_MODE_COUNT,
+  WS2812_MODE_RAINBOW = 0xFE,   // ws2812_err_2 的彩虹，不在 g_modes 里
+  WS2812_MODE_INVALID = 0xFF
+} ws2812_mode_t;
+
+typedef struct {
+  uint8_t  fx_mode;     // WS_FX_*（ws2812_render.h）
+  uint32_t color;       // 0xRRGGBB
+  uint16_t speed;       // 效果速度，含义见 WS_FX_*
+} ws2812_mode_def_t;
+
+/* =========================
+ * 模式表（你要改速度/效果，只改这里）
+ * ========================= */
+static const ws2812_mode_def_t g_modes[WS2812_MODE_COUNT] = {
+  // RED
+  { WS_FX_BREATH,          0xFF0000,  200 }, // RED_BREATH
+  { WS_FX_STATIC,          0xFF0000, 1000 }, // RED_SOLID
+  { WS_FX_RUNNING_LIGHTS,  0xFF0000,  900 }, // RED_FLOW
+  { WS_FX_BLINK,           0xFF0000,  500 }, // RED_BLINK
+
+  // YELLOW
+  { WS_FX_BREATH,          0xFFFF00,  200 }, // YELLOW_BREATH
+  { WS_FX_STATIC,          0xFFFF00, 1000 }, // YELLOW_SOLID
+  { WS_FX_RUNNING_LIGHTS,  0xFFFF00,  900 }, // YELLOW_FLOW
+  { WS_FX_BLINK,           0xFFFF00,  500 }, // YELLOW_BLINK
+
+  // GREEN
+  { WS_FX_BREATH,          0x00FF00,  200 }, // GREEN_BREATH
+  { WS_FX_STATIC,          0x00FF00, 1000 }, // GREEN_SOLID
+  { WS_FX_RUNNING_LIGHTS,  0x00FF00,  900 }, // GREEN_FLOW
+  { WS_FX_BLINK,           0x00FF00,  500 }, // GREEN_BLINK
+
+  { WS_FX_STATIC,          0x000000, 1000 }, // OFF
+};
@@ -0,0 +1,85 @@
+#include "ws2812_motion.h"
+#include "ws2812.h"
+#include "../servo/servo_in.h"
+
+namespace {
+
+/* =========================
+ * 绑定表（要改映射只改这里）
+ *   A/B/C 亮度跟 R/Y/Z 的转速：静止 60%，120 度/秒以上满亮
+ *   D/E 流水速度跟手臂 E/A：静止原速，150 度/秒时 3 倍速
+ * 默认关闭：只在演出表里标了 motion 的演出期间打开（show.cpp），动作播完自动关回原亮度，
+ * 平时的灯效不受影响
+ * ========================= */
+static const Ws2812MotionBinding k_bindings[] = {
+  { WS2812_PART_A, AX_R, WS_MOTION_SRC_SPEED, WS_MOTION_DST_LEVEL, 120, 150, 255 },
+  { WS2812_PART_B, AX_Y, WS_MOTION_SRC_SPEED, WS_MOTION_DST_LEVEL, 120, 150, 255 },
+  { WS2812_PART_C, AX_Z, WS_MOTION_SRC_SPEED, WS_MOTION_DST_LEVEL, 120, 150, 255 },
+  { WS2812_PART_D, AX_E, WS_MOTION_SRC_SPEED, WS_MOTION_DST_RATE,  150, 256, 768 },
+  { WS2812_PART_E, AX_A, WS_MOTION_SRC_SPEED, WS_MOTION_DST_RATE,  150, 256, 768 },
+};
+static_assert(sizeof(k_bindings) / sizeof(k_bindings[0]) <= WS2812_MOTION_MAX_BINDINGS, "too many motion bindings");
+
+static bool g_enabled = false;
+static uint32_t g_last_ms = 0;
+static Ws2812MotionStats g_stats = {};
+
+static inline uint16_t map_clamped(uint16_t in, const Ws2812MotionBinding &b)
+{
+  if (in >= b.in_max) return b.out_max;
+  return (uint16_t)(b.out_min + (int32_t)(b.out_max - b.out_min) * in / b.in_max);
+}
+
+} // namespace
+
+void ws2812_motion_service(uint32_t now_ms)
+{
+  if (!g_enabled) return;
+  if ((uint32_t)(now_ms - g_last_ms) < WS2812_MOTION_PERIOD_MS) return;
+  g_last_ms = now_ms;
+
+  if (!Servo_IsBusy()) {          // 演出的动作播完了
+    ws2812_motion_enable(false);
+    return;
+  }
+
+  uint32_t t0 = hal_micros();
+
+  ServoMotion m;
+  Servo_GetMotion(m);
+
+  // 同一分区可以同时绑亮度和速率，先攒齐再一次调制
+  uint8_t  level[WS2812_PART_MAX];
+  uint16_t rate[WS2812_PART_MAX];
+  for (uint8_t i = 0; i < WS2812_PART_MAX; i++) { level[i] = 255; rate[i] = 256; }
+
+  for (const auto &b : k_bindings) {
+    if (b.part >= WS2812_PART_MAX || b.axis >= AX_N) continue;
+    int16_t v = (b.src == WS_MOTION_SRC_SPEED) ? m.vel[b.axis] : m.off[b.axis];
+    uint16_t in = (uint16_t)(v < 0 ? -v : v);
+    uint16_t out = map_clamped(in, b);
+    if (b.dst == WS_MOTION_DST_LEVEL) level[b.part] = (uint8_t)(out > 255 ? 255 : out);
+    else                              rate[b.part] = out;
+  }
+
+  for (uint8_t i = 0; i < WS2812_PART_MAX; i++) {
+    ws_render_modulate(i, level[i], rate[i], now_ms);
+  }
+
+  uint32_t el = hal_micros() - t0;
+  if (el > g_stats.worst_us) g_stats.worst_us = el;
+  g_stats.frames++;
+}
+
+void ws2812_motion_enable(bool on)
+{
+  g_enabled = on;
+  if (on) return;
+  uint32_t now = hal_millis();
+  for (uint8_t i = 0; i < WS2812_PART_MAX; i++) ws_render_modulate(i, 255, 256, now);
+}
+
+const Ws2812MotionStats &ws2812_motion_stats()
+{
+  return g_stats;
+}
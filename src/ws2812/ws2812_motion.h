@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../hal/hal.h"
+
+/* =========================
+ * 灯效跟着动作走
+ *
+ * 每个灯效帧读一次播放器的运动快照（Servo_GetMotion，offset / 速度是写舵机时
+ * 顺手算好的），按绑定表映射到分区的亮度或效果速率（ws_render_modulate）。
+ * 绑定表固定大小，每帧开销 = 绑定数 × 几次整数运算，和动作内容无关。
+ * ========================= */
+#define WS2812_MOTION_MAX_BINDINGS  8
+#define WS2812_MOTION_PERIOD_MS     20     // 和舵机帧率对齐，没必要更快
+
+enum : uint8_t {
+  WS_MOTION_SRC_SPEED = 0,    // |速度|，度/秒
+  WS_MOTION_SRC_OFFSET,       // |offset|，度
+};
+
+enum : uint8_t {
+  WS_MOTION_DST_LEVEL = 0,    // 分区亮度 0..255
+  WS_MOTION_DST_RATE,         // 效果速率，256 = 原速
+};
+
+struct Ws2812MotionBinding {
+  uint8_t  part;      // ws2812_partition_t
+  uint8_t  axis;      // AX_*
+  uint8_t  src;       // WS_MOTION_SRC_*
+  uint8_t  dst;       // WS_MOTION_DST_*
+  uint16_t in_max;    // 输入到这个值时输出 out_max（输入 0 时输出 out_min）
+  uint16_t out_min;
+  uint16_t out_max;
+};
+
+struct Ws2812MotionStats {
+  uint32_t frames;        // 执行的联动帧
+  uint32_t worst_us;      // 单帧最长耗时
+};
+
+void ws2812_motion_service(uint32_t now_ms);   // ws2812_is_running() 里调用
+void ws2812_motion_enable(bool on);            // 默认关；打开后动作播完自动关，关掉时各分区恢复原亮度 / 原速
+const Ws2812MotionStats &ws2812_motion_stats();
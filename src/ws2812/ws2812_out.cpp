@@ -0,0 +1,159 @@
+#ifndef HAL_NATIVE
+
+#include "ws2812_out.h"
+#include "ws2812_px.h"
+#include <Arduino.h>
+#include "driver/rmt.h"
+#include <atomic>
+
+namespace {
+
+// RMT 时钟 80MHz / 2 = 40MHz，1 tick = 25ns
+#define WS_OUT_CLK_DIV   2
+#define WS_T0H_TICKS     16    // 0.40us
+#define WS_T0L_TICKS     34    // 0.85us
+#define WS_T1H_TICKS     32    // 0.80us
+#define WS_T1L_TICKS     18    // 0.45us
+
+alignas(4) static uint8_t g_tx[WS_OUT_MAX_LEDS * 3];   // 发送缓冲：RMT 发送期间不能动
+static WsOutStrip g_strips[WS_OUT_MAX_STRIPS];
+static rmt_channel_t g_ch[WS_OUT_MAX_STRIPS];   // 灯带 i 用的通道
+static uint8_t    g_ch_mask = 0;               // 所有在用通道的位
+static uint8_t    g_nstrips = 0;
+static uint16_t   g_bytes = 0;                 // 所有灯带合计字节数
+
+static std::atomic<uint8_t>  g_busy_mask{0};   // bit i = 通道 i 还在发
+static std::atomic<uint32_t> g_done_us{0};     // 最后一个通道发完的时间
+static uint32_t g_start_us = 0;
+static WsOutStats g_stats = {};
+
+// 中断里把字节翻译成 RMT 脉冲，高位先发
+static void IRAM_ATTR ws_translate(const void *src, rmt_item32_t *dest, size_t src_size,
+                                   size_t wanted_num, size_t *translated_size, size_t *item_num)
+{
+  if (src == nullptr || dest == nullptr) {
+    *translated_size = 0;
+    *item_num = 0;
+    return;
+  }
+
+  rmt_item32_t bit0, bit1;
+  bit0.level0 = 1; bit0.duration0 = WS_T0H_TICKS; bit0.level1 = 0; bit0.duration1 = WS_T0L_TICKS;
+  bit1.level0 = 1; bit1.duration0 = WS_T1H_TICKS; bit1.level1 = 0; bit1.duration1 = WS_T1L_TICKS;
+
+  const uint8_t *p = (const uint8_t *)src;
+  size_t size = 0;
+  size_t num = 0;
+  while (size < src_size && num + 8 <= wanted_num) {
+    uint8_t b = *p++;
+    for (uint8_t k = 0; k < 8; k++, b <<= 1) {
+      dest->val = (b & 0x80) ? bit1.val : bit0.val;
+      dest++;
+    }
+    num += 8;
+    size++;
+  }
+  *translated_size = size;
+  *item_num = num;
+}
+
+static void IRAM_ATTR ws_tx_end(rmt_channel_t channel, void *arg)
+{
+  (void)arg;
+  if ((int)channel >= 8) return;
+  uint8_t bit = (uint8_t)(1u << (int)channel);
+  uint8_t left = g_busy_mask.fetch_and((uint8_t)~bit, std::memory_order_acq_rel) & (uint8_t)~bit;
+  if (left == 0) g_done_us.store(micros(), std::memory_order_relaxed);
+}
+
+} // namespace
+
+bool ws_out_init(const WsOutStrip *strips, uint8_t n)
+{
+  if (n == 0 || n > WS_OUT_MAX_STRIPS) return false;
+
+  // 通道 i 用 mem_block_num 2 会占掉通道 i+1 的内存，只有路数少时才加大
+  uint8_t mem_blocks = (n <= WS_OUT_MAX_STRIPS / 2) ? 2 : 1;
+
+  g_bytes = 0;
+  g_ch_mask = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    const WsOutStrip &s = strips[i];
+    if ((uint32_t)s.first + s.count > WS_OUT_MAX_LEDS) return false;
+    g_strips[i] = s;
+    uint16_t end = (uint16_t)((s.first + s.count) * 3);
+    if (end > g_bytes) g_bytes = end;
+
+    // 两路时用通道 0 / 2，避开被借走内存的通道
+    rmt_channel_t ch = (rmt_channel_t)(i * mem_blocks);
+    g_ch[i] = ch;
+    g_ch_mask |= (uint8_t)(1u << (int)ch);
+    rmt_config_t cfg = RMT_DEFAULT_CONFIG_TX((gpio_num_t)s.pin, ch);
+    cfg.clk_div = WS_OUT_CLK_DIV;
+    cfg.mem_block_num = mem_blocks;   // 块多一点，WiFi 中断多时不容易断流
+    cfg.tx_config.idle_output_en = true;
+    cfg.tx_config.idle_level = 0;
+
+    if (rmt_config(&cfg) != ESP_OK) return false;
+    if (rmt_driver_install(ch, 0, 0) != ESP_OK) return false;
+    if (rmt_translator_init(ch, ws_translate) != ESP_OK) return false;
+  }
+  g_nstrips = n;
+  g_stats.strips = n;
+  rmt_register_tx_end_callback(ws_tx_end, nullptr);
+
+  g_done_us.store(micros(), std::memory_order_relaxed);
+  return true;
+}
+
+bool ws_out_busy()
+{
+  return g_busy_mask.load(std::memory_order_acquire) != 0;
+}
+
+bool ws_out_show(const uint8_t *grb, uint8_t scale)
+{
+  if (g_nstrips == 0) return false;
+
+  uint32_t now = micros();
+  if (ws_out_busy() || (uint32_t)(now - g_done_us.load(std::memory_order_relaxed)) < WS_OUT_RESET_US) {
+    g_stats.frames_deferred++;
+    return false;
+  }
+  if (g_stats.frames_sent) g_stats.last_tx_us = g_done_us.load(std::memory_order_relaxed) - g_start_us;
+
+  ws_px_scale(g_tx, grb, g_bytes, scale);
+  uint32_t prev_start = g_start_us;
+  g_start_us = now;
+
+  // 先把所有位置忙，再逐路启动，避免先发完的通道把"全部发完"提前报出去
+  g_busy_mask.store(g_ch_mask, std::memory_order_release);
+
+  uint8_t started = 0;
+  for (uint8_t i = 0; i < g_nstrips; i++) {
+    const WsOutStrip &s = g_strips[i];
+    rmt_channel_t ch = g_ch[i];
+    if (rmt_write_sample(ch, &g_tx[s.first * 3], (size_t)s.count * 3, false) != ESP_OK) {
+      g_busy_mask.fetch_and((uint8_t)~(1u << (int)ch), std::memory_order_acq_rel);
+      g_stats.tx_errors++;
+    } else {
+      started++;
+    }
+  }
+  // 一路都没起来：这帧没发出去，调用方保留脏标记下轮重推
+  if (started == 0) {
+    g_busy_mask.store(0, std::memory_order_release);
+    g_stats.frames_failed++;
+    g_start_us = prev_start;   // last_tx_us 还按上一帧算
+    return false;
+  }
+  g_stats.frames_sent++;
+  return true;
+}
+
+const WsOutStats &ws_out_stats()
+{
+  return g_stats;
+}
+
+#endif // HAL_NATIVE
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../hal/hal.h"
+
+/* =========================
+ * WS2812 输出（RMT，非阻塞，多路并行）
+ *
+ * 渲染器一直写自己的像素缓冲（逻辑上一整条）；灯带表把这条缓冲切成几段，
+ * 每段是一条物理灯带、占一个 RMT 通道。分区只看逻辑下标，跨不跨灯带无所谓。
+ * ws_out_show() 把整帧拷进发送缓冲（需要限流时边拷边缩），各通道同时启动后立即返回，
+ * 位时序由 RMT 硬件 + 中断里的翻译函数产生，不占 loop()。
+ * 上一帧还没发完（或复位间隔没到）时 show 返回 false，调用方保留脏标记下轮再推，
+ * 中间再渲染的帧直接覆盖，推出去的永远是最新画面。
+ *
+ * 主机上（HAL_NATIVE）换成 ws2812_out_native.cpp：不发线，按同样的线上时间模型报忙。
+ *
+ * 一帧的线上时间 ≈ 单路最长灯数 × 30us + 复位间隔；拆成 N 路并行大约快 N 倍。
+ * ========================= */
+#define WS_OUT_MAX_STRIPS    4             // S3 有 4 个 RMT 发送通道
+#define WS_OUT_MAX_LEDS      1200          // 发送缓冲上限（所有灯带合计）
+#define WS_OUT_RESET_US      300           // 帧间低电平，新版 WS2812B 要 >= 280us
+#define WS_OUT_US_PER_LED    30            // 800kHz × 24bit
+
+struct WsOutStrip {
+  int8_t   pin;
+  uint16_t first;     // 在逻辑缓冲里的起始灯号
+  uint16_t count;
+};
+
+struct WsOutStats {
+  uint32_t frames_sent;       // 启动发送的帧
+  uint32_t frames_deferred;   // 因为上一帧没发完 / 复位间隔没到而推迟的次数
+  uint32_t tx_errors;         // RMT 驱动返回错误（按通道计）
+  uint32_t frames_failed;     // 所有通道都没启动起来、整帧没发出去的次数
+  uint32_t last_tx_us;        // 最近一帧从启动到所有通道发完的时间
+  uint8_t  strips;
+};
+
+bool ws_out_init(const WsOutStrip *strips, uint8_t n);
+bool ws_out_show(const uint8_t *grb, uint8_t scale = 255);   // 非阻塞；scale 为整帧缩放（限流用）；返回 false = 发送中或全部通道启动失败，没发出去
+bool ws_out_busy();                     // true = 上一帧还在发
+const WsOutStats &ws_out_stats();
+
+#ifdef HAL_NATIVE
+// 主机实现（ws2812_out_native.cpp）：最近一次推出去的帧（GRB，已缩放）
+const uint8_t *ws_out_native_frame(uint16_t &bytes);
+#endif
@@ -0,0 +1,74 @@
+#ifdef HAL_NATIVE
+
+#include "ws2812_out.h"
+#include "ws2812_px.h"
+
+/*
+ * 主机上的灯带输出：不发线，只把缩放后的帧留在发送缓冲里给主机程序看。
+ * 忙 / 复位间隔按线上时间模型算（单路最长灯数 × WS_OUT_US_PER_LED + WS_OUT_RESET_US），
+ * 上层的推迟 / 脏标记逻辑和板子上走一样的分支。
+ */
+
+namespace {
+
+alignas(4) static uint8_t g_tx[WS_OUT_MAX_LEDS * 3];
+static uint8_t  g_nstrips = 0;
+static uint16_t g_bytes = 0;
+static uint32_t g_wire_us = 0;      // 一帧的线上时间（最长那一路）
+static uint32_t g_start_us = 0;
+static WsOutStats g_stats = {};
+
+} // namespace
+
+bool ws_out_init(const WsOutStrip *strips, uint8_t n)
+{
+  if (n == 0 || n > WS_OUT_MAX_STRIPS) return false;
+  g_bytes = 0;
+  g_wire_us = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    const WsOutStrip &s = strips[i];
+    if ((uint32_t)s.first + s.count > WS_OUT_MAX_LEDS) return false;
+    uint16_t end = (uint16_t)((s.first + s.count) * 3);
+    if (end > g_bytes) g_bytes = end;
+    if ((uint32_t)s.count * WS_OUT_US_PER_LED > g_wire_us) g_wire_us = (uint32_t)s.count * WS_OUT_US_PER_LED;
+  }
+  g_nstrips = n;
+  g_stats.strips = n;
+  g_start_us = hal_micros() - g_wire_us - WS_OUT_RESET_US;
+  return true;
+}
+
+bool ws_out_busy()
+{
+  return g_nstrips && (uint32_t)(hal_micros() - g_start_us) < g_wire_us;
+}
+
+bool ws_out_show(const uint8_t *grb, uint8_t scale)
+{
+  if (g_nstrips == 0) return false;
+
+  uint32_t now = hal_micros();
+  if ((uint32_t)(now - g_start_us) < g_wire_us + WS_OUT_RESET_US) {
+    g_stats.frames_deferred++;
+    return false;
+  }
+  if (g_stats.frames_sent) g_stats.last_tx_us = g_wire_us;
+
+  ws_px_scale(g_tx, grb, g_bytes, scale);
+  g_start_us = now;
+  g_stats.frames_sent++;
+  return true;
+}
+
+const WsOutStats &ws_out_stats()
+{
+  return g_stats;
+}
+
+const uint8_t *ws_out_native_frame(uint16_t &bytes)
+{
+  bytes = g_bytes;
+  return g_tx;
+}
+
+#endif // HAL_NATIVE
@@ -0,0 +1,66 @@
+#include "ws2812_power.h"
+#include "ws2812_px.h"
+
+namespace {
+
+static uint16_t g_ch_cur[256];      // 通道值 -> 电流（0.01mA），init 时按模型算好
+static uint16_t g_budget_ma = WS2812_POWER_BUDGET_MA;
+static Ws2812PowerStats g_stats = {};
+
+} // namespace
+
+void ws2812_power_init()
+{
+  for (int v = 0; v < 256; v++) {
+    g_ch_cur[v] = (uint16_t)((uint32_t)v * WS2812_MA_PER_CHANNEL_FULL * 100 / 255);
+  }
+  g_stats.last_scale = 255;
+}
+
+void ws2812_power_set_budget(uint16_t ma)
+{
+  g_budget_ma = ma;
+}
+
+uint16_t ws2812_power_budget()
+{
+  return g_budget_ma;
+}
+
+uint8_t ws2812_power_limit(const uint8_t *grb, uint16_t count)
+{
+  uint32_t sum = ws_px_lut_sum(grb, (size_t)count * 3, g_ch_cur);   // 0.01mA
+
+  uint32_t idle_ma = (uint32_t)count * WS2812_IDLE_UA_PER_LED / 1000;
+  uint32_t dyn_ma = sum / 100;
+  uint32_t est_ma = idle_ma + dyn_ma;
+
+  g_stats.frames++;
+  g_stats.last_est_ma = est_ma;
+  if (est_ma > g_stats.peak_est_ma) g_stats.peak_est_ma = est_ma;
+
+  uint8_t scale = 255;
+  if (est_ma > g_budget_ma && dyn_ma > 0) {
+    // 静态电流压不下来，只缩动态部分
+    uint32_t room = (g_budget_ma > idle_ma) ? g_budget_ma - idle_ma : 0;
+    scale = (uint8_t)(room * 255 / dyn_ma);
+  }
+
+  bool limiting = scale < 255;
+  if (limiting) {
+    g_stats.frames_limited++;
+    if (!g_stats.limiting) {
+      g_stats.limit_events++;
+      hal_log("ws2812 power limit: est %u mA > budget %u mA, scale %u\n",
+                    (unsigned)est_ma, (unsigned)g_budget_ma, (unsigned)scale);
+    }
+  }
+  g_stats.limiting = limiting;
+  g_stats.last_scale = scale;
+  return scale;
+}
+
+const Ws2812PowerStats &ws2812_power_stats()
+{
+  return g_stats;
+}
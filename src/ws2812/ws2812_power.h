@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../hal/hal.h"
+
+/* =========================
+ * 灯带电流预算
+ *
+ * 每次推帧前按电流模型估算整条灯带的电流：每个通道值查表得到电流（0.01mA），
+ * 加上每颗灯的静态电流。超过预算就算出一个缩放比例，推送时整帧等比调暗，
+ * 渲染缓冲本身不动（不影响脏帧判断和过渡）。
+ * 模型是线性近似：WS2812 每通道满占空约 20mA，静态约 1mA/颗。
+ * ========================= */
+#define WS2812_POWER_BUDGET_MA        1000   // 默认预算，和舵机共用 5V 时按电源余量定
+#define WS2812_MA_PER_CHANNEL_FULL    20     // 单通道 255 时的电流
+#define WS2812_IDLE_UA_PER_LED        1000   // 每颗灯静态电流（微安）
+
+struct Ws2812PowerStats {
+  uint32_t frames;            // 估算过的帧
+  uint32_t frames_limited;    // 被限流的帧
+  uint32_t limit_events;      // 从不限流进入限流的次数
+  uint32_t last_est_ma;       // 最近一帧估算电流（限流前）
+  uint32_t peak_est_ma;       // 开机以来最大估算电流（限流前）
+  uint8_t  last_scale;        // 最近一帧的缩放（255 = 没限）
+  bool     limiting;          // 当前是否在限流
+};
+
+void ws2812_power_init();
+void ws2812_power_set_budget(uint16_t ma);
+uint16_t ws2812_power_budget();
+
+// 估算 grb 这一帧的电流，返回推送时要用的缩放（255 = 不用缩）
+uint8_t ws2812_power_limit(const uint8_t *grb, uint16_t count);
+
+const Ws2812PowerStats &ws2812_power_stats();
@@ -0,0 +1,152 @@
+#include "ws2812_px.h"
+
+#include <string.h>
+
+namespace {
+
+#define PX_LO 0x00FF00FFu   // 每个 16 位通道的低字节
+
+static inline bool aligned4(const void *p)
+{
+  return ((uintptr_t)p & 3u) == 0;
+}
+
+// 4 个字节一起缩放：偶数字节和奇数字节分别放进两个 16 位通道，v × m <= 255 × 256 不会越界
+static inline uint32_t scale4(uint32_t x, uint32_t m)
+{
+  uint32_t lo = (((x & PX_LO) * m) >> 8) & PX_LO;
+  uint32_t hi = (((x >> 8) & PX_LO) * m) & ~PX_LO;
+  return lo | hi;
+}
+
+// 两个 0x00RRGGBB 混合：R、B 在一组通道，G 在另一组；inv + alpha = 256，和最大 255 × 256
+static inline uint32_t blend1(uint32_t a, uint32_t b, uint32_t alpha, uint32_t inv)
+{
+  uint32_t rb = (((a & PX_LO) * inv + (b & PX_LO) * alpha) >> 8) & PX_LO;
+  uint32_t g  = (((a >> 8) & 0xFFu) * inv + ((b >> 8) & 0xFFu) * alpha) & 0xFF00u;
+  return rb | g;
+}
+
+} // namespace
+
+void ws_px_scale_ref(uint8_t *dst, const uint8_t *src, size_t n, uint8_t s)
+{
+  uint16_t m = (uint16_t)s + 1;
+  for (size_t i = 0; i < n; i++) dst[i] = (uint8_t)(((uint16_t)src[i] * m) >> 8);
+}
+
+void ws_px_scale(uint8_t *dst, const uint8_t *src, size_t n, uint8_t s)
+{
+  if (s == 255) {
+    if (dst != src) memcpy(dst, src, n);
+    return;
+  }
+#if WS_PX_SWAR
+  if (aligned4(dst) && aligned4(src)) {
+    uint32_t m = (uint32_t)s + 1;
+    const uint32_t *s32 = (const uint32_t *)src;
+    uint32_t *d32 = (uint32_t *)dst;
+    size_t words = n / 4;
+    size_t w = 0;
+    for (; w + 4 <= words; w += 4) {
+      d32[w]     = scale4(s32[w], m);
+      d32[w + 1] = scale4(s32[w + 1], m);
+      d32[w + 2] = scale4(s32[w + 2], m);
+      d32[w + 3] = scale4(s32[w + 3], m);
+    }
+    for (; w < words; w++) d32[w] = scale4(s32[w], m);
+    ws_px_scale_ref(dst + words * 4, src + words * 4, n - words * 4, s);
+    return;
+  }
+#endif
+  ws_px_scale_ref(dst, src, n, s);
+}
+
+void ws_px_blend_ref(uint32_t *dst, const uint32_t *a, const uint32_t *b, size_t n, uint16_t alpha)
+{
+  uint16_t inv = 256 - alpha;
+  for (size_t i = 0; i < n; i++) {
+    uint32_t r  = (((a[i] >> 16) & 0xFF) * inv + ((b[i] >> 16) & 0xFF) * alpha) >> 8;
+    uint32_t g  = (((a[i] >> 8) & 0xFF) * inv + ((b[i] >> 8) & 0xFF) * alpha) >> 8;
+    uint32_t bl = ((a[i] & 0xFF) * inv + (b[i] & 0xFF) * alpha) >> 8;
+    dst[i] = (r << 16) | (g << 8) | bl;
+  }
+}
+
+void ws_px_blend(uint32_t *dst, const uint32_t *a, const uint32_t *b, size_t n, uint16_t alpha)
+{
+#if WS_PX_SWAR
+  uint32_t al = alpha;
+  uint32_t inv = 256u - alpha;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    dst[i]     = blend1(a[i], b[i], al, inv);
+    dst[i + 1] = blend1(a[i + 1], b[i + 1], al, inv);
+  }
+  for (; i < n; i++) dst[i] = blend1(a[i], b[i], al, inv);
+#else
+  ws_px_blend_ref(dst, a, b, n, alpha);
+#endif
+}
+
+// 查表没法按字并行；试过 4 个像素拼 3 个字再写，移位拼接省下的存储又花回去了，保持逐字节
+void ws_px_gamma_grb(uint8_t *grb, const uint32_t *rgb, size_t n, const uint8_t lut[256])
+{
+  for (size_t i = 0; i < n; i++, grb += 3) {
+    uint32_t c = rgb[i];
+    grb[0] = lut[(uint8_t)(c >> 8)];
+    grb[1] = lut[(uint8_t)(c >> 16)];
+    grb[2] = lut[(uint8_t)c];
+  }
+}
+
+void ws_px_palette_ref(uint32_t *dst, const uint8_t *idx, size_t n, const uint32_t *pal)
+{
+  for (size_t i = 0; i < n; i++) dst[i] = pal[idx[i]];
+}
+
+void ws_px_palette(uint32_t *dst, const uint8_t *idx, size_t n, const uint32_t *pal)
+{
+#if WS_PX_SWAR
+  if (aligned4(idx)) {
+    const uint32_t *i32 = (const uint32_t *)idx;
+    size_t words = n / 4;
+    for (size_t w = 0; w < words; w++, dst += 4) {
+      uint32_t x = i32[w];
+      // 小端：低字节是第一个索引
+      dst[0] = pal[x & 0xFF];
+      dst[1] = pal[(x >> 8) & 0xFF];
+      dst[2] = pal[(x >> 16) & 0xFF];
+      dst[3] = pal[x >> 24];
+    }
+    ws_px_palette_ref(dst, idx + words * 4, n - words * 4, pal);
+    return;
+  }
+#endif
+  ws_px_palette_ref(dst, idx, n, pal);
+}
+
+uint32_t ws_px_lut_sum_ref(const uint8_t *src, size_t n, const uint16_t lut[256])
+{
+  uint32_t sum = 0;
+  for (size_t i = 0; i < n; i++) sum += lut[src[i]];
+  return sum;
+}
+
+uint32_t ws_px_lut_sum(const uint8_t *src, size_t n, const uint16_t lut[256])
+{
+#if WS_PX_SWAR
+  if (aligned4(src)) {
+    const uint32_t *s32 = (const uint32_t *)src;
+    size_t words = n / 4;
+    uint32_t s0 = 0, s1 = 0;   // 两路累加，打断依赖链
+    for (size_t w = 0; w < words; w++) {
+      uint32_t x = s32[w];
+      s0 += lut[x & 0xFF] + lut[(x >> 16) & 0xFF];
+      s1 += lut[(x >> 8) & 0xFF] + lut[x >> 24];
+    }
+    return s0 + s1 + ws_px_lut_sum_ref(src + words * 4, n - words * 4, lut);
+  }
+#endif
+  return ws_px_lut_sum_ref(src, n, lut);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+/* =========================
+ * 像素批处理内核（不依赖 Arduino，主机上也能编译跑基准）
+ *
+ * 灯多了以后每帧的开销基本都在逐像素的小运算上：亮度缩放、颜色混合、gamma、调色板。
+ * 这里把它们写成一次处理一整段的函数，内层按 32 位字一次处理 4 个字节（SWAR），
+ * 两个 16 位通道里并排做 8×8 乘法，互不进位；结果和逐字节的参考实现逐位相同。
+ *
+ * WS_PX_SWAR = 0 时全部退回逐字节的参考实现（*_ref），方便对比。
+ * 指针没按 4 字节对齐时也走逐字节路径（Xtensa 不支持非对齐的 32 位读写）。
+ * ========================= */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef WS_PX_SWAR
+#define WS_PX_SWAR 1
+#endif
+
+// 每个字节 v -> (v × (s + 1)) >> 8，s = 255 时原样
+void ws_px_scale(uint8_t *dst, const uint8_t *src, size_t n, uint8_t s);
+
+// 颜色（0x00RRGGBB）逐通道混合：(a × (256 - alpha) + b × alpha) >> 8，alpha 0..256
+void ws_px_blend(uint32_t *dst, const uint32_t *a, const uint32_t *b, size_t n, uint16_t alpha);
+
+// 颜色（0x00RRGGBB）查 gamma 表后写成 GRB 字节（只有逐字节实现）
+void ws_px_gamma_grb(uint8_t *grb, const uint32_t *rgb, size_t n, const uint8_t lut[256]);
+
+// 调色板：索引 -> 颜色
+void ws_px_palette(uint32_t *dst, const uint8_t *idx, size_t n, const uint32_t *pal);
+
+// 每个字节查 16 位表求和（电流估算用）
+uint32_t ws_px_lut_sum(const uint8_t *src, size_t n, const uint16_t lut[256]);
+
+// 逐字节参考实现，基准和一致性检查用
+void ws_px_scale_ref(uint8_t *dst, const uint8_t *src, size_t n, uint8_t s);
+void ws_px_blend_ref(uint32_t *dst, const uint32_t *a, const uint32_t *b, size_t n, uint16_t alpha);
+void ws_px_palette_ref(uint32_t *dst, const uint8_t *idx, size_t n, const uint32_t *pal);
+uint32_t ws_px_lut_sum_ref(const uint8_t *src, size_t n, const uint16_t lut[256]);
@@ -0,0 +1,346 @@
+#include "ws2812_render.h"
+#include "ws2812_px.h"
+
+#include <string.h>
+
+namespace {
+
+// gamma 2.2：效果和混合都在感知亮度上算，写缓冲时查表换成 LED 的线性占空比
+static const uint8_t k_gamma8[256] = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+    1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+    3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+    6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+   12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+   20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+   30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+   42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+   56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+   73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+   91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+  113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+  137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+  163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+  192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+  223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+struct WsFx {
+  uint8_t  fx;
+  uint32_t color;       // 0xRRGGBB
+  uint16_t speed;
+  uint32_t t0_ms;       // 效果起点
+};
+
+// 还没生效的设置：同一帧内多次设置只留最后一次，下一帧统一比较、生效
+struct WsPending {
+  bool     valid;
+  uint16_t start;
+  uint16_t end;
+  uint8_t  fx;
+  uint32_t color;
+  uint16_t speed;
+  uint16_t fade_ms;
+};
+
+struct WsPart {
+  WsPending pending;
+  bool     enabled;
+  bool     dirty;       // 参数变了，下一帧必须重画
+  bool     held;        // 暂停绘制（像素由别人写）
+  uint16_t start;
+  uint16_t end;         // 闭区间
+  WsFx     cur;
+  WsFx     prev;        // 过渡中：旧效果
+  uint32_t fade_t0_ms;
+  uint16_t fade_ms;     // 0 = 没有过渡
+  uint32_t key;         // 上次画的画面键
+  uint8_t  level;       // 外部调制：分区亮度（255 = 不变）
+  uint16_t rate_q8;     // 外部调制：效果速率（256 = 1 倍）
+};
+
+static WsPart   g_parts_rt[WS_RENDER_MAX_PARTS];
+static uint8_t *g_pix = nullptr;
+static uint16_t g_count = 0;
+static uint8_t  g_bri = 255;
+static uint32_t g_last_frame_ms = 0;
+static WsRenderStats g_stats = {};
+
+static inline uint8_t scale8(uint8_t v, uint8_t s)
+{
+  return (uint8_t)(((uint16_t)v * ((uint16_t)s + 1)) >> 8);
+}
+
+static inline uint32_t scale_rgb(uint32_t rgb, uint8_t s)
+{
+  return ((uint32_t)scale8((uint8_t)(rgb >> 16), s) << 16) |
+         ((uint32_t)scale8((uint8_t)(rgb >> 8), s) << 8) |
+         scale8((uint8_t)rgb, s);
+}
+
+static inline uint8_t tri8(uint8_t x)
+{
+  return (x < 128) ? (uint8_t)(x * 2) : (uint8_t)((255 - x) * 2);
+}
+
+// 色环：0..255 -> 红 -> 绿 -> 蓝 -> 红
+static inline uint32_t wheel(uint8_t pos)
+{
+  pos = 255 - pos;
+  if (pos < 85)  return ((uint32_t)(255 - pos * 3) << 16) | (pos * 3);
+  if (pos < 170) { pos -= 85; return ((uint32_t)(pos * 3) << 8) | (255 - pos * 3); }
+  pos -= 170;
+  return ((uint32_t)(pos * 3) << 16) | ((uint32_t)(255 - pos * 3) << 8);
+}
+
+// 一段算好的颜色写进缓冲（GRB）：批量查 gamma、乘亮度，和缓冲里原来的比较后再写
+static void put_span(uint16_t first, const uint32_t *rgb, uint16_t n, uint8_t bri, bool &changed)
+{
+  alignas(4) uint8_t grb[WS_RENDER_CHUNK * 3];
+  ws_px_gamma_grb(grb, rgb, n, k_gamma8);
+  ws_px_scale(grb, grb, (size_t)n * 3, bri);
+
+  uint8_t *p = &g_pix[first * 3];
+  if (memcmp(p, grb, (size_t)n * 3) != 0) {
+    memcpy(p, grb, (size_t)n * 3);
+    changed = true;
+  }
+}
+
+// 画面键：同一个键画出来的像素完全相同
+// rate_q8 > 256 表示加快（等效 speed 变小）
+static uint32_t fx_key(const WsFx &f, uint32_t t, uint16_t rate_q8 = 256)
+{
+  uint32_t sp = (uint32_t)f.speed * 256 / (rate_q8 ? rate_q8 : 1);
+  if (sp == 0) sp = 1;
+  switch (f.fx) {
+    case WS_FX_BLINK:
+      return (t / sp) & 1;
+    case WS_FX_BREATH: {
+      uint32_t period = sp * 10;
+      uint8_t ph = (uint8_t)((uint64_t)(t % period) * 256 / period);
+      return WS_BREATH_FLOOR + scale8(tri8(ph), 255 - WS_BREATH_FLOOR);
+    }
+    case WS_FX_RUNNING_LIGHTS: {
+      uint32_t step_ms = sp / 16 ? sp / 16 : 1;
+      return t / step_ms;
+    }
+    case WS_FX_RAINBOW_CYCLE:
+      return (uint32_t)((uint64_t)t * 256 / (sp * 4)) & 0xFF;
+    case WS_FX_STATIC:
+    default:
+      return 0;
+  }
+}
+
+// 效果在分区内第 idx 个灯的颜色（感知亮度，未乘全局亮度）
+static inline uint32_t fx_rgb(const WsFx &f, uint32_t key, uint16_t idx, uint16_t len)
+{
+  switch (f.fx) {
+    case WS_FX_BLINK:
+      return key ? f.color : 0;
+    case WS_FX_BREATH:
+      return scale_rgb(f.color, (uint8_t)key);
+    case WS_FX_RUNNING_LIGHTS:
+      return scale_rgb(f.color, tri8((uint8_t)(idx * 32 - (uint8_t)(key * 16))));
+    case WS_FX_RAINBOW_CYCLE:
+      return wheel((uint8_t)((uint32_t)idx * 256 / len + key));
+    case WS_FX_STATIC:
+    default:
+      return f.color;
+  }
+}
+
+static inline uint8_t part_bri(const WsPart &p)
+{
+  return scale8(g_bri, p.level);
+}
+
+// 分区按 WS_RENDER_CHUNK 个灯一段：先逐灯算颜色，再整段交给像素内核
+static void part_draw(const WsPart &p, uint32_t key, bool &changed)
+{
+  alignas(4) uint32_t row[WS_RENDER_CHUNK];
+  uint16_t len = p.end - p.start + 1;
+  uint8_t bri = part_bri(p);
+  for (uint16_t base = 0; base < len; base += WS_RENDER_CHUNK) {
+    uint16_t n = (len - base < WS_RENDER_CHUNK) ? len - base : WS_RENDER_CHUNK;
+    for (uint16_t k = 0; k < n; k++) row[k] = fx_rgb(p.cur, key, base + k, len);
+    put_span(p.start + base, row, n, bri, changed);
+  }
+}
+
+// 过渡中：新旧效果各算一遍再整段混合，每灯开销固定
+static void part_draw_fade(const WsPart &p, uint32_t key, uint32_t prev_key, uint16_t alpha, bool &changed)
+{
+  alignas(4) uint32_t a[WS_RENDER_CHUNK];
+  alignas(4) uint32_t b[WS_RENDER_CHUNK];
+  uint16_t len = p.end - p.start + 1;
+  uint8_t bri = part_bri(p);
+  for (uint16_t base = 0; base < len; base += WS_RENDER_CHUNK) {
+    uint16_t n = (len - base < WS_RENDER_CHUNK) ? len - base : WS_RENDER_CHUNK;
+    for (uint16_t k = 0; k < n; k++) {
+      a[k] = fx_rgb(p.prev, prev_key, base + k, len);
+      b[k] = fx_rgb(p.cur, key, base + k, len);
+    }
+    ws_px_blend(a, a, b, n, alpha);
+    put_span(p.start + base, a, n, bri, changed);
+  }
+}
+
+} // namespace
+
+void ws_render_init(uint8_t *pixels, uint16_t count)
+{
+  g_pix = pixels;
+  g_count = count;
+  for (auto &p : g_parts_rt) {
+    p = WsPart{};
+    p.level = 255;
+    p.rate_q8 = 256;
+  }
+  g_stats = {};
+}
+
+void ws_render_brightness(uint8_t b)
+{
+  if (b == g_bri) return;
+  g_bri = b;
+  for (auto &p : g_parts_rt) p.dirty = true;
+}
+
+uint8_t ws_render_brightness_get()
+{
+  return g_bri;
+}
+
+bool ws_render_set(uint8_t part, uint16_t start, uint16_t end,
+                   uint8_t fx, uint32_t color, uint16_t speed, uint16_t fade_ms)
+{
+  if (part >= WS_RENDER_MAX_PARTS || fx >= WS_FX_COUNT || g_count == 0) return false;
+  if (start >= g_count) return false;
+  if (end >= g_count) end = g_count - 1;
+  if (end < start) return false;
+
+  WsPending &q = g_parts_rt[part].pending;
+  g_stats.set_calls++;
+  if (q.valid) g_stats.sets_coalesced++;
+  q = WsPending{ true, start, end, fx, color, speed, fade_ms };
+  return true;
+}
+
+void ws_render_modulate(uint8_t part, uint8_t level, uint16_t rate_q8, uint32_t now_ms)
+{
+  if (part >= WS_RENDER_MAX_PARTS) return;
+  WsPart &p = g_parts_rt[part];
+  if (rate_q8 == 0) rate_q8 = 1;
+
+  if (rate_q8 != p.rate_q8) {
+    // 换速率时把起点挪一下，让 t × rate 连续，画面不跳
+    uint32_t t = now_ms - p.cur.t0_ms;
+    p.cur.t0_ms = now_ms - (uint32_t)((uint64_t)t * p.rate_q8 / rate_q8);
+    p.rate_q8 = rate_q8;
+  }
+  if (level != p.level) {
+    p.level = level;
+    p.dirty = true;
+  }
+}
+
+void ws_render_disable(uint8_t part)
+{
+  if (part >= WS_RENDER_MAX_PARTS) return;
+  g_parts_rt[part].enabled = false;
+  g_parts_rt[part].pending.valid = false;
+}
+
+void ws_render_hold(uint8_t part, bool on)
+{
+  if (part >= WS_RENDER_MAX_PARTS) return;
+  WsPart &p = g_parts_rt[part];
+  if (p.held && !on) p.dirty = true;
+  p.held = on;
+}
+
+void ws_render_invalidate()
+{
+  for (auto &p : g_parts_rt) p.dirty = true;
+}
+
+// 把挂起的设置生效；和当前完全相同的直接丢掉，不重置效果相位
+static void part_commit(WsPart &p, uint32_t now_ms)
+{
+  WsPending &q = p.pending;
+  q.valid = false;
+
+  bool same_range = p.enabled && q.start == p.start && q.end == p.end;
+  if (same_range && q.fx == p.cur.fx && q.color == p.cur.color && q.speed == p.cur.speed) {
+    g_stats.sets_unchanged++;
+    return;
+  }
+  g_stats.sets_applied++;
+
+  // 过渡起点：分区之前没亮就从黑开始；上一个过渡还没过半就接着从更旧的效果淡出
+  if (!p.enabled) {
+    p.prev = WsFx{ WS_FX_STATIC, 0, 1000, now_ms };
+  } else if (!(p.fade_ms && (uint32_t)(now_ms - p.fade_t0_ms) * 2 < p.fade_ms)) {
+    p.prev = p.cur;
+  }
+  p.fade_t0_ms = now_ms;
+  p.fade_ms = (same_range || !p.enabled) ? q.fade_ms : 0;   // 范围变了不做过渡
+
+  p.enabled = true;
+  p.dirty = true;
+  p.start = q.start;
+  p.end = q.end;
+  p.cur = WsFx{ q.fx, q.color, q.speed, now_ms };
+}
+
+bool ws_render_frame(uint32_t now_ms)
+{
+  if (!g_pix) return false;
+  if ((uint32_t)(now_ms - g_last_frame_ms) < WS_RENDER_MIN_FRAME_MS) return false;
+  g_last_frame_ms = now_ms;
+  g_stats.frames_checked++;
+
+  bool rendered = false;
+  bool changed = false;
+  for (auto &p : g_parts_rt) {
+    if (p.pending.valid) part_commit(p, now_ms);
+    if (!p.enabled) continue;
+    if (p.held) { g_stats.parts_skipped++; continue; }
+    uint32_t key = fx_key(p.cur, now_ms - p.cur.t0_ms, p.rate_q8);
+
+    if (p.fade_ms) {
+      uint32_t el = now_ms - p.fade_t0_ms;
+      if (el >= p.fade_ms) {
+        p.fade_ms = 0;        // 过渡结束，最后按新效果完整画一次
+        p.dirty = true;
+      } else {
+        uint16_t alpha = (uint16_t)(el * 256 / p.fade_ms);
+        part_draw_fade(p, key, fx_key(p.prev, now_ms - p.prev.t0_ms), alpha, changed);
+        p.key = key;
+        rendered = true;
+        g_stats.parts_rendered++;
+        g_stats.parts_faded++;
+        continue;
+      }
+    }
+
+    if (!p.dirty && key == p.key) { g_stats.parts_skipped++; continue; }
+
+    part_draw(p, key, changed);
+    p.key = key;
+    p.dirty = false;
+    rendered = true;
+    g_stats.parts_rendered++;
+  }
+
+  if (rendered) g_stats.frames_rendered++;
+  if (changed)  g_stats.frames_changed++;
+  return changed;
+}
+
+const WsRenderStats &ws_render_stats()
+{
+  return g_stats;
+}
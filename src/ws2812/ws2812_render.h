@@ -0,0 +1,72 @@
+#pragma once
+
+/* =========================
+ * 分区灯效渲染（不依赖 Arduino，主机上也能编译跑基准）
+ *
+ * 直接写像素缓冲（GRB，每灯 3 字节，和 NeoPixel NEO_GRB 内部布局一致）。
+ * 每个效果先算一个"画面键"：键只由时间决定，键不变画面就不变，
+ * 分区参数没改且键没变的直接跳过；重画时逐字节比较，
+ * 整帧没有任何像素变化就不需要 show()。
+ *
+ * 换效果可带过渡时间：过渡期间新旧效果逐灯按 alpha 定点混合（每灯开销固定），
+ * 输出统一查 gamma 表，淡入淡出在人眼看来是均匀的。
+ * 混合、gamma、亮度这些逐灯运算按段批量交给 ws2812_px 里的内核。
+ * ========================= */
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 效果（替代 WS2812FX 的 FX_MODE_*，只实现本项目用到的几种）
+enum : uint8_t {
+  WS_FX_STATIC = 0,
+  WS_FX_BREATH,           // 整段亮度三角波，speed × 10 ms 一个周期
+  WS_FX_RUNNING_LIGHTS,   // 8 灯一个波长向前流动，speed / 16 ms 走一步
+  WS_FX_BLINK,            // 亮 speed ms、灭 speed ms
+  WS_FX_RAINBOW_CYCLE,    // 整段铺一圈色环并旋转，speed × 4 ms 转一圈
+  WS_FX_COUNT
+};
+
+#define WS_RENDER_MAX_PARTS     16
+#define WS_RENDER_MIN_FRAME_MS  10     // 最高 100 帧/秒，呼吸这类每毫秒都在变的效果也不会刷爆
+#define WS_BREATH_FLOOR         40     // 呼吸最暗不到 0（感知亮度，过 gamma 后约 2%）
+#define WS_RENDER_CHUNK         32     // 分区按这么多灯一段交给像素内核（ws2812_px.h），栈上约 0.4KB
+
+struct WsRenderStats {
+  uint32_t frames_checked;    // 到了帧间隔、检查过的帧
+  uint32_t frames_rendered;   // 至少重画了一个分区的帧
+  uint32_t frames_changed;    // 像素真的有变化、需要 show() 的帧
+  uint32_t parts_rendered;    // 重画的分区次数
+  uint32_t parts_skipped;     // 参数和画面键都没变而跳过的分区次数
+  uint32_t parts_faded;       // 过渡中混合绘制的分区次数
+
+  uint32_t set_calls;         // ws_render_set 调用次数
+  uint32_t sets_coalesced;    // 同一帧内被后一次设置覆盖掉的
+  uint32_t sets_unchanged;    // 和当前效果完全相同、没有重置的
+  uint32_t sets_applied;      // 真正生效的
+};
+
+void ws_render_init(uint8_t *pixels, uint16_t count);
+void ws_render_brightness(uint8_t b);
+uint8_t ws_render_brightness_get();
+
+// 设置分区效果；end 为闭区间，超出灯数的部分裁掉
+// 设置先挂起，下一帧开头统一生效：同一帧内多次设置只算最后一次，
+// 和当前 (fx, color, speed, 范围) 完全相同的直接忽略，效果相位不会被重置
+// fade_ms > 0 时从当前画面淡到新效果（分区范围变了则直接切）
+bool ws_render_set(uint8_t part, uint16_t start, uint16_t end,
+                   uint8_t fx, uint32_t color, uint16_t speed, uint16_t fade_ms = 0);
+void ws_render_disable(uint8_t part);
+void ws_render_invalidate();    // 所有分区下一帧强制重画（外面清过像素缓冲时用）
+
+// 暂停某个分区的绘制（比如片段播放器正在写这段像素）：设置照常生效、相位照走，
+// 只是不往缓冲里画；放开后下一帧整段重画
+void ws_render_hold(uint8_t part, bool on);
+
+// 外部调制（比如跟着舵机速度走）：level 分区亮度 0..255，rate_q8 效果速率（256 = 原速）
+// 不算新设置，不重置相位，也不触发过渡
+void ws_render_modulate(uint8_t part, uint8_t level, uint16_t rate_q8, uint32_t now_ms);
+
+// 每次 loop 调用；返回 true 表示像素缓冲变了，调用方负责 show()
+bool ws_render_frame(uint32_t now_ms);
+
+const WsRenderStats &ws_render_stats();
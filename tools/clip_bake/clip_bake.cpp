@@ -0,0 +1,203 @@
+/*
+ * 主机端灯效片段烘焙工具
+ *
+ * 编译：g++ -std=c++17 -O2 -o clip_bake tools/clip_bake/clip_bake.cpp src/ws2812/ws2812_clip.cpp
+ *
+ * 用法：
+ *   clip_bake <in.rgb> <out.wscl> <width> <fps> [first] [loop]
+ *       in.rgb 为连续的 RGB24 帧（每帧 width × 3 字节），比如
+ *       ffmpeg -i a.gif -vf scale=50:1 -f rawvideo -pix_fmt rgb24 in.rgb
+ *   clip_bake demo <out.wscl> <width> <fps> [first] [loop]
+ *       生成一段彗星扫过的示例片段
+ *
+ * 输出格式见 src/ws2812/ws2812_clip.h：烘焙时做 gamma 2.2、换成 GRB；
+ * 颜色不超过 256 种就用调色板，游程压缩更小就开 RLE。
+ * 写完把每一帧用固件的解码函数解一遍，和输入逐字节对比。
+ * 上传：link_host upload ... 或 curl -X POST --data-binary @out.wscl 'http://<ip>/api/upload?name=/clip/x.wscl'
+ */
+
+#include "../../src/ws2812/ws2812_clip.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+// 与 ws2812_clip_player.h 保持一致（那边带 Arduino.h，主机上不能直接包含）
+#define BAKE_FRAME_MAX 1024
+
+typedef std::vector<uint8_t> Bytes;
+
+static void put_u16(Bytes &b, uint16_t v)
+{
+  b.push_back((uint8_t)v);
+  b.push_back((uint8_t)(v >> 8));
+}
+
+static uint8_t gamma8(uint8_t v)
+{
+  return (uint8_t)lround(pow(v / 255.0, 2.2) * 255.0);
+}
+
+// 一帧的元素序列（调色板索引或 GRB）编码成负载
+static Bytes encode(const Bytes &elems, size_t esz, bool rle)
+{
+  if (!rle) return elems;
+  Bytes out;
+  size_t n = elems.size() / esz;
+  for (size_t i = 0; i < n;) {
+    size_t run = 1;
+    while (i + run < n && run < 255 && memcmp(&elems[i * esz], &elems[(i + run) * esz], esz) == 0) run++;
+    out.push_back((uint8_t)run);
+    out.insert(out.end(), elems.begin() + i * esz, elems.begin() + (i + 1) * esz);
+    i += run;
+  }
+  return out;
+}
+
+static std::vector<Bytes> demo_frames(uint16_t width, uint8_t fps)
+{
+  std::vector<Bytes> frames;
+  int n = fps * 2;   // 2 秒扫一遍
+  for (int f = 0; f < n; f++) {
+    Bytes rgb(width * 3u, 0);
+    double head = (double)f * (width + 8) / n;
+    for (int i = 0; i < width; i++) {
+      double d = head - i;
+      if (d < 0 || d > 8) continue;
+      uint8_t v = (uint8_t)(255 * (1.0 - d / 8));
+      rgb[i * 3] = v;
+      rgb[i * 3 + 1] = (uint8_t)(v / 3);
+      rgb[i * 3 + 2] = (uint8_t)(v / 8);
+    }
+    frames.push_back(rgb);
+  }
+  return frames;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 5) {
+    fprintf(stderr, "usage: clip_bake <in.rgb|demo> <out.wscl> <width> <fps> [first] [loop]\n");
+    return 1;
+  }
+  uint16_t width = (uint16_t)atoi(argv[3]);
+  int fps = atoi(argv[4]);
+  uint16_t first = (argc > 5) ? (uint16_t)atoi(argv[5]) : 0;
+  bool loop = (argc > 6) && atoi(argv[6]) != 0;
+  if (width == 0 || fps <= 0 || fps > WS_CLIP_MAX_FPS) {
+    fprintf(stderr, "bad width or fps (1..%d)\n", WS_CLIP_MAX_FPS);
+    return 1;
+  }
+
+  // 读入 RGB 帧
+  std::vector<Bytes> frames;
+  if (strcmp(argv[1], "demo") == 0) {
+    frames = demo_frames(width, (uint8_t)fps);
+  } else {
+    FILE *in = fopen(argv[1], "rb");
+    if (!in) { perror(argv[1]); return 1; }
+    Bytes rgb(width * 3u);
+    while (fread(rgb.data(), 1, rgb.size(), in) == rgb.size()) frames.push_back(rgb);
+    fclose(in);
+  }
+  if (frames.empty() || frames.size() > 0xFFFF) {
+    fprintf(stderr, "need 1..65535 frames, got %u\n", (unsigned)frames.size());
+    return 1;
+  }
+
+  // gamma + 换成 GRB，顺便统计颜色
+  std::map<uint32_t, uint8_t> colors;
+  bool palette = true;
+  std::vector<Bytes> grb(frames.size());
+  for (size_t f = 0; f < frames.size(); f++) {
+    grb[f].resize(width * 3u);
+    for (uint16_t i = 0; i < width; i++) {
+      uint8_t r = gamma8(frames[f][i * 3]), g = gamma8(frames[f][i * 3 + 1]), b = gamma8(frames[f][i * 3 + 2]);
+      grb[f][i * 3] = g; grb[f][i * 3 + 1] = r; grb[f][i * 3 + 2] = b;
+      uint32_t key = ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+      if (palette && !colors.count(key)) {
+        if (colors.size() == 256) palette = false;
+        else colors[key] = (uint8_t)colors.size();
+      }
+    }
+  }
+
+  Bytes pal;
+  if (palette) {
+    pal.resize(colors.size() * 3);
+    for (const auto &c : colors) {
+      pal[c.second * 3] = (uint8_t)(c.first >> 16);
+      pal[c.second * 3 + 1] = (uint8_t)(c.first >> 8);
+      pal[c.second * 3 + 2] = (uint8_t)c.first;
+    }
+  }
+
+  // 每帧的元素序列
+  size_t esz = palette ? 1 : 3;
+  std::vector<Bytes> elems(frames.size());
+  for (size_t f = 0; f < frames.size(); f++) {
+    if (!palette) { elems[f] = grb[f]; continue; }
+    for (uint16_t i = 0; i < width; i++) {
+      uint32_t key = ((uint32_t)grb[f][i * 3] << 16) | ((uint32_t)grb[f][i * 3 + 1] << 8) | grb[f][i * 3 + 2];
+      elems[f].push_back(colors[key]);
+    }
+  }
+
+  // RLE 整体更小才开（标志是全片段的）
+  size_t raw_total = 0, rle_total = 0;
+  for (const auto &e : elems) { raw_total += e.size(); rle_total += encode(e, esz, true).size(); }
+  bool rle = rle_total < raw_total;
+
+  Bytes out(WS_CLIP_MAGIC, WS_CLIP_MAGIC + 4);
+  uint8_t flags = (palette ? WS_CLIP_F_PALETTE : 0) | (rle ? WS_CLIP_F_RLE : 0) | (loop ? WS_CLIP_F_LOOP : 0);
+  out.push_back(WS_CLIP_VERSION);
+  out.push_back(flags);
+  out.push_back((uint8_t)fps);
+  out.push_back(palette ? (uint8_t)colors.size() : 0);   // 256 写成 0
+  put_u16(out, first);
+  put_u16(out, width);
+  put_u16(out, (uint16_t)frames.size());
+  put_u16(out, 0);
+  out.insert(out.end(), pal.begin(), pal.end());
+
+  size_t max_payload = 0;
+  std::vector<Bytes> payloads;
+  for (const auto &e : elems) {
+    Bytes p = encode(e, esz, rle);
+    if (p.size() > max_payload) max_payload = p.size();
+    put_u16(out, (uint16_t)p.size());
+    out.insert(out.end(), p.begin(), p.end());
+    payloads.push_back(p);
+  }
+
+  // 用固件的解码函数回读校验
+  WsClipHeader h;
+  if (!ws_clip_parse_header(out.data(), out.size(), h)) { fprintf(stderr, "header self-check failed\n"); return 1; }
+  Bytes dec(width * 3u);
+  for (size_t f = 0; f < payloads.size(); f++) {
+    if (!ws_clip_decode(h, pal.data(), payloads[f].data(), payloads[f].size(), dec.data()) || dec != grb[f]) {
+      fprintf(stderr, "frame %u self-check failed\n", (unsigned)f);
+      return 1;
+    }
+  }
+
+  FILE *fo = fopen(argv[2], "wb");
+  if (!fo) { perror(argv[2]); return 1; }
+  fwrite(out.data(), 1, out.size(), fo);
+  fclose(fo);
+
+  size_t raw_rgb = frames.size() * width * 3u;
+  printf("%s: %u frames x %u leds @ %d fps, first %u%s\n", argv[2], (unsigned)frames.size(), (unsigned)width,
+         fps, (unsigned)first, loop ? ", loop" : "");
+  printf("  %s%s, %u bytes (raw %u, %.1f%%), max frame %u bytes\n",
+         palette ? "palette" : "grb", rle ? "+rle" : "", (unsigned)out.size(), (unsigned)raw_rgb,
+         100.0 * out.size() / raw_rgb, (unsigned)max_payload);
+  if (max_payload > BAKE_FRAME_MAX) {
+    fprintf(stderr, "warning: frame larger than player buffer (%d bytes), device will reject it\n", BAKE_FRAME_MAX);
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * 主机端拆核对比：真时钟跑主机固件，一直播演出，量两次 loop()（每次一个 Servo_Update）之间的间隔，
+ * 和 /metrics 的 servo_gap_us 同一个口径（只算播放动作期间）
+ *
+ * 编译两份（在仓库根目录），SPLIT=0 是 io_step 在 loop 里直接跑，SPLIT=1 是 io_step 在单独线程：
+ *   for SPLIT in 0 1; do
+ *   g++ -std=gnu++17 -O2 -DHAL_NATIVE -DCORE_SPLIT=$SPLIT -DCORES_NATIVE_THREAD -Isrc -pthread \
+ *       -o core_bench_$SPLIT tools/core_bench/core_bench.cpp \
+ *       src/main.cpp src/hal/hal_native.cpp src/config/config.cpp src/servo/servo_in.cpp \
+ *       src/sys/sys.cpp src/sys/cores.cpp src/sys/bus.cpp src/uart/uart_in.cpp src/stream/led_*.cpp src/stream/stream_in.cpp \
+ *       src/show/show.cpp src/upload/upload.cpp src/ws2812/ws2812*.cpp src/ASR/ASR_module.cpp
+ *   done
+ *
+ * 用法（在仓库根目录跑）：core_bench_N [seconds] [show_id]     默认 10 秒，演出 0x0D
+ *
+ * 主机上 IO 侧只有语音模块轮询（I2C 假件按 100 kHz 算传输时间，见 hal_native.cpp）和命令串口解析；
+ * 板子上 IO 侧还有 WiFi / 遥测广播，它们的耗时主机上没法复现，那部分看板子上的 /metrics。
+ * SPLIT=1 时 loop 不让出（和 loopTask 一样一直转），IO 线程每轮让出 1ms；主机上要有两个空闲核才测得准。
+ */
+
+#include "../../src/hal/hal_native.h"
+#include "../../src/uart/uart_in.h"
+#include "../../src/servo/servo_in.h"
+#include "../../src/sys/cores.h"
+#include "../../src/ASR/ASR_module.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+void setup();
+void loop();
+
+static void start_show(uint8_t id)
+{
+  uint8_t cmd[UART_FRAME_LEN] = { UART_FRAME_HEAD0, UART_FRAME_HEAD1, 0x00, id, 0, UART_FRAME_TAIL };
+  cmd[4] = uart_crc8(&cmd[2], 2);
+  hal_native_uart_inject(UART_IN_PORT, cmd, sizeof(cmd));
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t seconds = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 0) : 10;
+  uint8_t  show    = argc > 2 ? (uint8_t)strtoul(argv[2], nullptr, 0) : 0x0D;
+
+  if (CORE_SPLIT && std::thread::hardware_concurrency() < 2) {
+    fprintf(stderr, "warning: only one cpu, rt loop and io thread time-slice; max gap is the scheduler quantum\n");
+  }
+
+  int devnull = open("/dev/null", O_WRONLY);   // 固件日志不要混进结果
+  int saved = dup(STDOUT_FILENO);
+  if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+
+  uint8_t none = 0;                            // 语音模块挂上总线（一直回“没识别到”）
+  hal_native_i2c_inject(I2C_ADDR, ASR_RESULT_ADDR, &none, 1);
+  setup();
+
+  std::vector<uint32_t> gaps;
+  gaps.reserve(seconds * 20000);
+  uint32_t t_end = hal_millis() + seconds * 1000;
+  uint32_t last_us = hal_micros();
+  uint32_t shows = 0;
+  uint32_t idle_since = hal_millis() - 1000;
+  while ((int32_t)(hal_millis() - t_end) < 0) {
+    // 播完一遍空闲 200ms 再发下一遍（命令要经 IO 侧解析，发完不会马上 busy）
+    if (!Servo_IsBusy() && hal_millis() - idle_since >= 200) {
+      start_show(show);
+      shows++;
+      idle_since = hal_millis();
+    }
+    hal_native_uart_poll();
+    loop();
+    uint32_t now = hal_micros();
+    if (Servo_IsBusy()) { gaps.push_back(now - last_us); idle_since = hal_millis(); }
+    last_us = now;
+  }
+
+  fflush(stdout);
+  dup2(saved, STDOUT_FILENO);
+  if (gaps.empty()) { fprintf(stderr, "show 0x%02x never started\n", show); return 1; }
+
+  std::sort(gaps.begin(), gaps.end());
+  uint64_t sum = 0;
+  for (uint32_t g : gaps) sum += g;
+  const CoreStats &cs = cores_stats();
+  printf("CORE_SPLIT=%d (%s): %u s, show 0x%02x x%u, %zu servo updates\n", CORE_SPLIT,
+         cs.split ? "io thread" : "io inline", seconds, show, shows, gaps.size());
+  printf("  servo_gap_us  mean %llu  p50 %u  p99 %u  max %u\n",
+         (unsigned long long)(sum / gaps.size()), gaps[gaps.size() / 2],
+         gaps[gaps.size() * 99 / 100], gaps.back());
+  printf("  busy  rt %u%%  io %u%%\n", cs.busy_pct[CORE_RT], cs.busy_pct[CORE_IO]);
+  return 0;
+}
@@ -0,0 +1,241 @@
+/*
+ * 主机端灯效渲染基准
+ *
+ * 编译：g++ -std=c++17 -O2 -o led_bench tools/led_bench/led_bench.cpp \
+ *         src/ws2812/ws2812_render.cpp src/ws2812/ws2812_px.cpp
+ *
+ * 用法：
+ *   led_bench [leds] [seconds]     默认 50 灯，模拟 10 秒（每 1 ms 调一次 ws_render_frame）
+ *   led_bench px                   只跑像素内核：先和参考实现逐位对比，再测吞吐（像素/微秒）
+ *
+ * 对 g_modes 每一项（外加彩虹、过渡）整条灯带跑一遍，输出：
+ *   rendered / pushed   重画帧数 / 像素真正变化（需要 show）的帧数
+ *   ns/call             每次 ws_render_frame 调用的平均耗时（含跳过的）
+ *
+ * 最后一张表是不同灯数、不同并行路数下能跑到的帧率上限：
+ *   渲染耗时用本机实测（彩虹，每帧整条重画），线上时间按 WS2812 时序算
+ *   （单路最长灯数 × 30us + 复位间隔）。RMT 发送和下一帧渲染是重叠的，
+ *   所以一帧的周期取两者较大的那个，再受 WS_RENDER_MIN_FRAME_MS 封顶。
+ *   板子上的实际发送时间看 /metrics 的 ws2812_tx_us。
+ */
+
+#include "../../src/ws2812/ws2812_modes.h"
+#include "../../src/ws2812/ws2812_px.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static const char *const k_names[WS2812_MODE_COUNT] = {
+  "RED_BREATH",    "RED_SOLID",    "RED_FLOW",    "RED_BLINK",
+  "YELLOW_BREATH", "YELLOW_SOLID", "YELLOW_FLOW", "YELLOW_BLINK",
+  "GREEN_BREATH",  "GREEN_SOLID",  "GREEN_FLOW",  "GREEN_BLINK",
+  "OFF",
+};
+
+static void run(const char *name, uint8_t fx, uint32_t color, uint16_t speed, uint16_t leds, uint32_t seconds)
+{
+  std::vector<uint8_t> pix(leds * 3u, 0);
+  ws_render_init(pix.data(), leds);
+  ws_render_brightness(100);
+  ws_render_set(0, 0, leds - 1, fx, color, speed);
+
+  uint32_t sim_ms = seconds * 1000;
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t now = 0; now < sim_ms; now++) ws_render_frame(now);
+  auto t1 = std::chrono::steady_clock::now();
+
+  const WsRenderStats &st = ws_render_stats();
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+  printf("%-14s checked %6u  rendered %6u  pushed %6u  %6.0f ns/call  (%.1f fps pushed)\n",
+         name, (unsigned)st.frames_checked, (unsigned)st.frames_rendered, (unsigned)st.frames_changed,
+         ns / sim_ms, st.frames_changed * 1000.0 / sim_ms);
+}
+
+// 过渡：每秒在黄呼吸和红闪之间切一次，每次 500 ms 淡入淡出
+static void run_fade(uint16_t leds, uint32_t seconds)
+{
+  std::vector<uint8_t> pix(leds * 3u, 0);
+  ws_render_init(pix.data(), leds);
+  ws_render_brightness(100);
+
+  uint32_t sim_ms = seconds * 1000;
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t now = 0; now < sim_ms; now++) {
+    if (now % 1000 == 0) {
+      const ws2812_mode_def_t &m = g_modes[(now / 1000) & 1 ? WS2812_MODE_RED_BLINK : WS2812_MODE_YELLOW_BREATH];
+      ws_render_set(0, 0, leds - 1, m.fx_mode, m.color, m.speed, 500);
+    }
+    ws_render_frame(now);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  const WsRenderStats &st = ws_render_stats();
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+  printf("%-14s checked %6u  rendered %6u  pushed %6u  %6.0f ns/call  (%u faded, %.0f ns/faded px)\n",
+         "FADE 500ms", (unsigned)st.frames_checked, (unsigned)st.frames_rendered, (unsigned)st.frames_changed,
+         ns / sim_ms, (unsigned)st.parts_faded,
+         st.parts_faded ? ns / st.parts_faded / leds : 0.0);
+}
+
+// 与 ws2812_out.h 保持一致（那边带 Arduino.h，主机上不能直接包含）
+#define BENCH_US_PER_LED   30
+#define BENCH_RESET_US     300
+#define BENCH_MAX_STRIPS   4
+
+// 整条彩虹每帧重画一次的平均耗时（ns）
+static double render_ns_per_frame(uint16_t leds)
+{
+  std::vector<uint8_t> pix(leds * 3u, 0);
+  ws_render_init(pix.data(), leds);
+  ws_render_brightness(100);
+  ws_render_set(0, 0, leds - 1, WS_FX_RAINBOW_CYCLE, 0, 1200);
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t now = 0; now < 20000; now += WS_RENDER_MIN_FRAME_MS) ws_render_frame(now);
+  auto t1 = std::chrono::steady_clock::now();
+
+  const WsRenderStats &st = ws_render_stats();
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+  return st.frames_rendered ? ns / st.frames_rendered : 0.0;
+}
+
+static void fps_table()
+{
+  static const uint16_t k_counts[] = { 50, 150, 300, 600, 1200 };
+  const double cap = 1000.0 / WS_RENDER_MIN_FRAME_MS;
+
+  printf("\nmax fps (render overlapped with tx, capped at %.0f):\n", cap);
+  printf("%6s %10s", "leds", "render us");
+  for (int s = 1; s <= BENCH_MAX_STRIPS; s++) printf("  %d strip%s", s, s > 1 ? "s" : " ");
+  printf("\n");
+
+  for (uint16_t leds : k_counts) {
+    double render_us = render_ns_per_frame(leds) / 1000.0;
+    printf("%6u %10.1f", (unsigned)leds, render_us);
+    for (int s = 1; s <= BENCH_MAX_STRIPS; s++) {
+      uint32_t per_strip = (leds + s - 1) / s;
+      double wire_us = (double)per_strip * BENCH_US_PER_LED + BENCH_RESET_US;
+      double period = wire_us > render_us ? wire_us : render_us;
+      double fps = 1e6 / period;
+      printf("  %8.0f", fps < cap ? fps : cap);
+    }
+    printf("\n");
+  }
+}
+
+/* ---------- 像素内核 ---------- */
+
+#define PX_BENCH_LEDS   1200
+#define PX_BENCH_ROUNDS 2000
+
+static uint32_t rnd()
+{
+  static uint32_t x = 2463534242u;
+  x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+  return x;
+}
+
+// 所有缩放值 / 混合系数都跑一遍，长度故意不是 4 的倍数，起点也错开，覆盖尾巴和非对齐路径
+static bool px_check()
+{
+  const size_t n = PX_BENCH_LEDS + 3;
+  alignas(4) uint8_t src8[n * 3 + 4], f8[n * 3 + 4], r8[n * 3 + 4];
+  alignas(4) uint32_t a[n], b[n], f32[n], r32[n];
+  uint16_t lut16[256];
+  uint32_t pal[256];
+  for (size_t i = 0; i < sizeof(src8); i++) src8[i] = (uint8_t)rnd();
+  for (size_t i = 0; i < n; i++) { a[i] = rnd() & 0xFFFFFF; b[i] = rnd() & 0xFFFFFF; }
+  for (int i = 0; i < 256; i++) { lut16[i] = (uint16_t)rnd(); pal[i] = rnd() & 0xFFFFFF; }
+
+  int bad = 0;
+  for (size_t off = 0; off < 4; off++) {
+    size_t len = n * 3 - off;
+    for (int s = 0; s < 256; s++) {
+      ws_px_scale(f8 + off, src8 + off, len, (uint8_t)s);
+      ws_px_scale_ref(r8 + off, src8 + off, len, (uint8_t)s);
+      if (memcmp(f8 + off, r8 + off, len) != 0) { printf("scale mismatch s=%d off=%u\n", s, (unsigned)off); bad++; }
+    }
+    if (ws_px_lut_sum(src8 + off, len, lut16) != ws_px_lut_sum_ref(src8 + off, len, lut16)) {
+      printf("lut_sum mismatch off=%u\n", (unsigned)off); bad++;
+    }
+    ws_px_palette(f32, src8 + off, n, pal);
+    ws_px_palette_ref(r32, src8 + off, n, pal);
+    if (memcmp(f32, r32, n * 4) != 0) { printf("palette mismatch off=%u\n", (unsigned)off); bad++; }
+  }
+  for (int al = 0; al <= 256; al++) {
+    ws_px_blend(f32, a, b, n, (uint16_t)al);
+    ws_px_blend_ref(r32, a, b, n, (uint16_t)al);
+    if (memcmp(f32, r32, n * 4) != 0) { printf("blend mismatch alpha=%d\n", al); bad++; }
+  }
+  printf("px kernels vs reference: %s\n", bad ? "MISMATCH" : "bit-identical");
+  return bad == 0;
+}
+
+template <class F>
+static double px_per_us(F &&f)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < PX_BENCH_ROUNDS; r++) f(r);
+  auto t1 = std::chrono::steady_clock::now();
+  double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+  return (double)PX_BENCH_LEDS * PX_BENCH_ROUNDS / us;
+}
+
+static volatile uint32_t g_sink;
+
+static void px_bench()
+{
+  const size_t n = PX_BENCH_LEDS;
+  alignas(4) static uint8_t src8[n * 3], dst8[n * 3];
+  alignas(4) static uint32_t a[n], b[n], d32[n];
+  static uint8_t lut8[256];
+  static uint16_t lut16[256];
+  static uint32_t pal[256];
+  for (size_t i = 0; i < n * 3; i++) src8[i] = (uint8_t)rnd();
+  for (size_t i = 0; i < n; i++) { a[i] = rnd() & 0xFFFFFF; b[i] = rnd() & 0xFFFFFF; }
+  for (int i = 0; i < 256; i++) { lut8[i] = (uint8_t)i; lut16[i] = (uint16_t)(i * 7); pal[i] = (uint32_t)i * 0x010101; }
+
+  printf("\n%-10s %10s %10s   (px/us, %u px per call)\n", "kernel", "scalar", "batched", (unsigned)n);
+  printf("%-10s %10.1f %10.1f\n", "scale",
+         px_per_us([&](int r) { ws_px_scale_ref(dst8, src8, n * 3, (uint8_t)(r | 1)); g_sink = dst8[r % (n * 3)]; }),
+         px_per_us([&](int r) { ws_px_scale(dst8, src8, n * 3, (uint8_t)(r | 1)); g_sink = dst8[r % (n * 3)]; }));
+  printf("%-10s %10.1f %10.1f\n", "blend",
+         px_per_us([&](int r) { ws_px_blend_ref(d32, a, b, n, (uint16_t)(r & 255)); g_sink = d32[r % n]; }),
+         px_per_us([&](int r) { ws_px_blend(d32, a, b, n, (uint16_t)(r & 255)); g_sink = d32[r % n]; }));
+  printf("%-10s %10.1f %10s\n", "gamma",
+         px_per_us([&](int r) { ws_px_gamma_grb(dst8, a, n, lut8); g_sink = dst8[r % (n * 3)]; }), "-");
+  printf("%-10s %10.1f %10.1f\n", "palette",
+         px_per_us([&](int r) { ws_px_palette_ref(d32, src8, n, pal); g_sink = d32[r % n]; }),
+         px_per_us([&](int r) { ws_px_palette(d32, src8, n, pal); g_sink = d32[r % n]; }));
+  printf("%-10s %10.1f %10.1f\n", "lut_sum",
+         px_per_us([&](int) { g_sink = ws_px_lut_sum_ref(src8, n * 3, lut16); }),
+         px_per_us([&](int) { g_sink = ws_px_lut_sum(src8, n * 3, lut16); }));
+}
+
+int main(int argc, char **argv)
+{
+  if (argc > 1 && strcmp(argv[1], "px") == 0) {
+    if (!px_check()) return 1;
+    px_bench();
+    return 0;
+  }
+
+  uint16_t leds = (argc > 1) ? (uint16_t)atoi(argv[1]) : 50;
+  uint32_t seconds = (argc > 2) ? (uint32_t)atoi(argv[2]) : 10;
+  if (leds == 0 || seconds == 0) {
+    fprintf(stderr, "usage: led_bench [leds] [seconds]\n");
+    return 1;
+  }
+
+  printf("%u leds, %u s simulated\n", (unsigned)leds, (unsigned)seconds);
+  for (int m = 0; m < WS2812_MODE_COUNT; m++) {
+    run(k_names[m], g_modes[m].fx_mode, g_modes[m].color, g_modes[m].speed, leds, seconds);
+  }
+  run("RAINBOW", WS_FX_RAINBOW_CYCLE, 0, 1200, leds, seconds);
+  run_fade(leds, seconds);
+  fps_table();
+  return 0;
+}
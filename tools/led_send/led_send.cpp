@@ -0,0 +1,192 @@
+/*
+ * 主机端实时灯光帧发送 / 回环接收（Linux）
+ *
+ * 编译：g++ -std=c++17 -O2 -o led_send tools/led_send/led_send.cpp src/stream/led_rx.cpp
+ *
+ * 用法：
+ *   led_send artnet|e131 <host> [leds] [fps] [seconds] [jitter_ms] [drop_pct]
+ *       按 fps 发彩虹流动帧；jitter_ms 给每帧加 0..jitter 的随机延迟，drop_pct 随机丢包
+ *   led_send listen [leds] [seconds]
+ *       在 6454 / 5568 上收包，喂给和固件同一份的 led_rx（拼帧 + 抖动缓冲），
+ *       每秒打印统计，最后对比到达间隔和出帧间隔的抖动
+ *
+ * 本机回环：
+ *   led_send listen 50 10 &
+ *   led_send artnet 127.0.0.1 50 40 8 12 2
+ *
+ * 串口同样的帧：link_host leds <tty>
+ */
+
+#include "../../src/stream/led_rx.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+static uint32_t now_ms()
+{
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static int cmd_send(bool artnet, const char *host, int leds, int fps, int seconds, int jitter_ms, int drop_pct)
+{
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) { perror("socket"); return 1; }
+  sockaddr_in to{};
+  to.sin_family = AF_INET;
+  to.sin_port = htons(artnet ? LED_PROTO_ARTNET_PORT : LED_PROTO_E131_PORT);
+  if (inet_pton(AF_INET, host, &to.sin_addr) != 1) { fprintf(stderr, "bad host %s\n", host); return 1; }
+
+  std::mt19937 rng(1);
+  std::vector<uint8_t> rgb(leds * 3u);
+  uint8_t pkt[LED_PROTO_E131_HDR + LED_PROTO_DMX_MAX];
+  int unis = (leds + LED_PROTO_LEDS_PER_UNI - 1) / LED_PROTO_LEDS_PER_UNI;
+  long sent = 0, dropped = 0;
+
+  auto period = std::chrono::microseconds(1000000 / fps);
+  auto next = std::chrono::steady_clock::now();
+  long total = (long)fps * seconds;
+  for (long k = 0; k < total; k++) {
+    for (int i = 0; i < leds; i++) {
+      double h = (i * 1.0 / leds + k * 0.01) * 2.0 * M_PI;
+      rgb[i * 3]     = (uint8_t)(127.5 + 127.5 * std::sin(h));
+      rgb[i * 3 + 1] = (uint8_t)(127.5 + 127.5 * std::sin(h + 2.094));
+      rgb[i * 3 + 2] = (uint8_t)(127.5 + 127.5 * std::sin(h + 4.189));
+    }
+    if (jitter_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(rng() % (jitter_ms + 1)));
+
+    uint8_t seq = (uint8_t)(k % 255 + 1);   // 0 表示不编号，跳过
+    for (int u = 0; u < unis; u++) {
+      int first = u * LED_PROTO_LEDS_PER_UNI;
+      int n = std::min(LED_PROTO_LEDS_PER_UNI, leds - first);
+      if ((int)(rng() % 100) < drop_pct) { dropped++; continue; }
+      size_t len = artnet ? led_proto_build_artnet(pkt, (uint16_t)u, seq, &rgb[first * 3], (uint16_t)(n * 3))
+                          : led_proto_build_e131(pkt, (uint16_t)u, seq, &rgb[first * 3], (uint16_t)(n * 3));
+      if (sendto(fd, pkt, len, 0, (sockaddr *)&to, sizeof(to)) < 0) { perror("sendto"); return 1; }
+      sent++;
+    }
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+  printf("sent %ld packets (%ld dropped on purpose), %ld frames x %d leds at %d fps\n",
+         sent, dropped, total, leds, fps);
+  close(fd);
+  return 0;
+}
+
+static int udp_bind(uint16_t port)
+{
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) { perror("socket"); return -1; }
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in a{};
+  a.sin_family = AF_INET;
+  a.sin_port = htons(port);
+  a.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(fd, (sockaddr *)&a, sizeof(a)) < 0) { perror("bind"); close(fd); return -1; }
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+  return fd;
+}
+
+// 间隔序列的标准差
+struct Jitter {
+  uint32_t last = 0;
+  double sum = 0, sum2 = 0;
+  long n = 0;
+  void note(uint32_t t) {
+    if (last) { double d = (double)(t - last); sum += d; sum2 += d * d; n++; }
+    last = t;
+  }
+  double mean() const { return n ? sum / n : 0; }
+  double sd() const { return n > 1 ? std::sqrt(std::max(0.0, sum2 / n - mean() * mean())) : 0; }
+};
+
+static int cmd_listen(int leds, int seconds)
+{
+  int fa = udp_bind(LED_PROTO_ARTNET_PORT);
+  int fe = udp_bind(LED_PROTO_E131_PORT);
+  if (fa < 0 || fe < 0) return 1;
+  led_rx_init((uint16_t)leds);
+
+  Jitter arrive, play;
+  uint32_t frames_seen = 0;
+  uint8_t buf[1500];
+  uint32_t t_end = now_ms() + (uint32_t)seconds * 1000;
+  uint32_t t_print = now_ms() + 1000;
+
+  while ((int32_t)(now_ms() - t_end) < 0) {
+    for (int fd : { fa, fe }) {
+      ssize_t n;
+      while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+        LedDmx d;
+        bool ok = (fd == fa) ? led_proto_parse_artnet(buf, (size_t)n, d) : led_proto_parse_e131(buf, (size_t)n, d);
+        if (!ok) { led_rx_bad_packet(); continue; }
+        uint32_t t = now_ms();
+        led_rx_dmx(d, t);
+        if (led_rx_stats().frames != frames_seen) { frames_seen = led_rx_stats().frames; arrive.note(t); }
+      }
+    }
+
+    // 消费者：和 ws2812_is_running 一样 peek / consume
+    uint32_t t = now_ms();
+    if (led_rx_active(t) && led_rx_peek(t)) {
+      led_rx_consume(t);
+      play.note(t);
+    }
+
+    if ((int32_t)(t - t_print) >= 0) {
+      t_print += 1000;
+      const LedRxStats &s = led_rx_stats();
+      printf("pkts %u frames %u played %u | late %u incomplete %u overflow %u skipped %u underrun %u | period %u ms depth %u\n",
+             s.packets, s.frames, s.played, s.late_drops, s.incomplete, s.overflow_drops, s.skipped,
+             s.underruns, s.period_ms, s.depth);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  printf("arrival interval %.1f ms (sd %.2f), playout interval %.1f ms (sd %.2f)\n",
+         arrive.mean(), arrive.sd(), play.mean(), play.sd());
+  close(fa);
+  close(fe);
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2) {
+    fprintf(stderr, "usage: led_send artnet|e131 <host> [leds] [fps] [seconds] [jitter_ms] [drop_pct]\n"
+                    "       led_send listen [leds] [seconds]\n");
+    return 2;
+  }
+  if (!strcmp(argv[1], "listen")) {
+    int leds = argc > 2 ? atoi(argv[2]) : 50;
+    int seconds = argc > 3 ? atoi(argv[3]) : 10;
+    if (leds <= 0 || leds > LED_RX_MAX_LEDS) { fprintf(stderr, "leds 1..%d\n", LED_RX_MAX_LEDS); return 2; }
+    return cmd_listen(leds, seconds);
+  }
+  bool artnet = !strcmp(argv[1], "artnet");
+  if ((!artnet && strcmp(argv[1], "e131")) || argc < 3) {
+    fprintf(stderr, "unknown command %s\n", argv[1]);
+    return 2;
+  }
+  int leds = argc > 3 ? atoi(argv[3]) : 50;
+  int fps = argc > 4 ? atoi(argv[4]) : 40;
+  int seconds = argc > 5 ? atoi(argv[5]) : 10;
+  int jitter = argc > 6 ? atoi(argv[6]) : 0;
+  int drop = argc > 7 ? atoi(argv[7]) : 0;
+  if (leds <= 0 || fps <= 0) return 2;
+  return cmd_send(artnet, argv[2], leds, fps, seconds, jitter, drop);
+}
@@ -0,0 +1,403 @@
+/*
+ * 主机端串口工具（Linux / macOS）
+ *
+ * 编译：g++ -std=c++17 -O2 -o link_host tools/link_host/link_host.cpp
+ *
+ * 用法：
+ *   link_host stream <tty> [baud] [hz] [seconds]   以 hz 频率发 7 轴正弦设定点
+ *   link_host dump   <tty> [baud]                  解包并打印收到的数据包
+ *   link_host upload <tty> <baud> <local> <remote> [chunk] [window]
+ *                                                  分块上传文件到设备 LittleFS（可续传）
+ *   link_host leds   <tty> [baud] [leds] [fps] [seconds]
+ *                                                  发实时灯光帧（彩虹流动），设备端见 stream/led_in.h
+ *
+ * 波特率：9600 … 921600，Linux 上还有 1000000 / 1500000 / 2000000；不支持的直接报错
+ *
+ * 上传回环测试（主机固件 + 伪终端，断点续传后逐字节比对）见 link_loopback.cpp
+ *
+ * 无硬件时可用伪终端对测：
+ *   socat -d -d pty,raw,echo=0 pty,raw,echo=0
+ *   link_host dump /dev/pts/X &  link_host stream /dev/pts/Y 115200 100 5
+ */
+
+#include "../../src/uart/link_frame.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+// 不认识的波特率返回 false，不要悄悄退回 115200（吞吐数字会没有意义）
+static bool to_speed(long baud, speed_t &out)
+{
+  switch (baud) {
+    case 9600:    out = B9600;    return true;
+    case 57600:   out = B57600;   return true;
+    case 115200:  out = B115200;  return true;
+    case 230400:  out = B230400;  return true;
+#ifdef B460800
+    case 460800:  out = B460800;  return true;
+#endif
+#ifdef B921600
+    case 921600:  out = B921600;  return true;
+#endif
+#ifdef B1000000
+    case 1000000: out = B1000000; return true;
+#endif
+#ifdef B1500000
+    case 1500000: out = B1500000; return true;
+#endif
+#ifdef B2000000
+    case 2000000: out = B2000000; return true;
+#endif
+    default:      return false;
+  }
+}
+
+// 原始模式，读 0.1s 超时；伪终端主端也用它
+static bool tty_setup(int fd, speed_t speed)
+{
+  termios tio{};
+  tcgetattr(fd, &tio);
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, speed);
+  cfsetospeed(&tio, speed);
+  tio.c_cc[VMIN]  = 0;
+  tio.c_cc[VTIME] = 1;
+  if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+    perror("tcsetattr");
+    return false;
+  }
+  return true;
+}
+
+#ifndef LINK_HOST_NO_MAIN
+static int open_tty(const char *path, long baud)
+{
+  speed_t speed;
+  if (!to_speed(baud, speed)) {
+    fprintf(stderr, "unsupported baud %ld on this system\n", baud);
+    return -1;
+  }
+  int fd = open(path, O_RDWR | O_NOCTTY);
+  if (fd < 0) { perror(path); return -1; }
+  if (!tty_setup(fd, speed)) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+#endif // LINK_HOST_NO_MAIN
+
+static uint32_t now_ms()
+{
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static bool write_all(int fd, const uint8_t *p, size_t n)
+{
+  while (n > 0) {
+    ssize_t w = write(fd, p, n);
+    if (w < 0 && errno == EAGAIN) {     // 非阻塞的 fd（伪终端主端）缓冲满了，等一会儿
+      pollfd pf = { fd, POLLOUT, 0 };
+      poll(&pf, 1, 100);
+      continue;
+    }
+    if (w <= 0) return false;
+    p += w;
+    n -= (size_t)w;
+  }
+  return true;
+}
+
+#ifndef LINK_HOST_NO_MAIN
+static int cmd_stream(int fd, int hz, int seconds)
+{
+  uint8_t payload[LINK_SETPOINT_LEN];
+  uint8_t frame[LINK_SETPOINT_LEN + LINK_OVERHEAD];
+  uint16_t seq = 0;
+
+  auto period = std::chrono::microseconds(1000000 / hz);
+  auto next = std::chrono::steady_clock::now();
+  uint32_t t0 = now_ms();
+  long total = (long)hz * seconds;
+
+  for (long k = 0; k < total; k++) {
+    uint32_t t = now_ms();
+    link_put_u16(payload, seq++);
+    link_put_u32(payload + 2, t);
+    for (int i = 0; i < LINK_SETPOINT_AXES; i++) {
+      double ph = (t - t0) / 1000.0 * 2.0 * M_PI * 0.5 + i * 0.7;
+      link_put_u16(payload + 6 + 2 * i, (uint16_t)(int16_t)std::lround(30.0 * std::sin(ph)));
+    }
+    size_t n = link_frame_encode(LINK_TYPE_SETPOINT, payload, sizeof(payload), frame);
+    if (!write_all(fd, frame, n)) { perror("write"); return 1; }
+
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+  printf("sent %ld setpoint packets at %d Hz\n", total, hz);
+  return 0;
+}
+
+static int cmd_dump(int fd)
+{
+  uint8_t frame[LINK_MAX_PAYLOAD + LINK_OVERHEAD];
+  size_t idx = 0, need = 0;
+  unsigned long ok = 0, bad = 0;
+
+  for (;;) {
+    uint8_t b;
+    if (read(fd, &b, 1) != 1) continue;
+
+    if (idx == 0 && b != LINK_HEAD0) continue;
+    if (idx == 1 && b != LINK_HEAD1) { idx = 0; continue; }
+    frame[idx++] = b;
+    if (idx == 4) need = frame[3] + LINK_OVERHEAD;
+    if (idx < 4 || idx < need) continue;
+    idx = 0;
+
+    uint8_t len = frame[3];
+    if (link_crc16(&frame[2], 2 + len) != link_get_u16(&frame[4 + len])) {
+      printf("crc error (ok=%lu bad=%lu)\n", ok, ++bad);
+      continue;
+    }
+    ok++;
+    if (frame[2] == LINK_TYPE_SETPOINT && len >= LINK_SETPOINT_LEN) {
+      const uint8_t *p = &frame[4];
+      printf("seq=%u t=%u", link_get_u16(p), link_get_u32(p + 2));
+      for (int i = 0; i < LINK_SETPOINT_AXES; i++) printf(" %d", (int16_t)link_get_u16(p + 6 + 2 * i));
+      printf("\n");
+    } else {
+      printf("type=0x%02X len=%u\n", frame[2], len);
+    }
+    fflush(stdout);
+  }
+}
+#endif // LINK_HOST_NO_MAIN
+
+// 从串口里捞数据包（跳过调试日志等杂字节），超时返回 false
+struct LinkReader {
+  uint8_t frame[LINK_MAX_PAYLOAD + LINK_OVERHEAD];
+  size_t idx = 0, need = 0;
+
+  bool next(int fd, uint8_t &type, const uint8_t *&payload, uint8_t &len, int timeout_ms)
+  {
+    uint32_t deadline = now_ms() + timeout_ms;
+    while ((int32_t)(deadline - now_ms()) > 0) {
+      uint8_t b;
+      if (read(fd, &b, 1) != 1) continue;
+
+      if (idx == 0 && b != LINK_HEAD0) continue;
+      if (idx == 1 && b != LINK_HEAD1) { idx = 0; continue; }
+      frame[idx++] = b;
+      if (idx == 4) need = frame[3] + LINK_OVERHEAD;
+      if (idx < 4 || idx < need) continue;
+      idx = 0;
+
+      len = frame[3];
+      if (link_crc16(&frame[2], 2 + len) != link_get_u16(&frame[4 + len])) continue;
+      type = frame[2];
+      payload = &frame[4];
+      return true;
+    }
+    return false;
+  }
+
+  // 等一个 UP_ACK
+  bool ack(int fd, uint8_t &status, uint32_t &a, uint32_t &b, int timeout_ms)
+  {
+    uint8_t type, len;
+    const uint8_t *p;
+    uint32_t deadline = now_ms() + timeout_ms;
+    while ((int32_t)(deadline - now_ms()) > 0) {
+      if (!next(fd, type, p, len, (int)(deadline - now_ms()))) return false;
+      if (type != LINK_TYPE_UP_ACK || len < LINK_UP_ACK_LEN) continue;
+      status = p[0];
+      a = link_get_u32(p + 1);
+      b = link_get_u32(p + 5);
+      return true;
+    }
+    return false;
+  }
+};
+
+static bool send_packet(int fd, uint8_t type, const uint8_t *payload, uint8_t len)
+{
+  uint8_t frame[LINK_MAX_PAYLOAD + LINK_OVERHEAD];
+  size_t n = link_frame_encode(type, payload, len, frame);
+  return n && write_all(fd, frame, n);
+}
+
+#ifndef LINK_HOST_NO_MAIN
+// 一帧按 LINK_LED_MAX_LEDS 分块，最后一块带 END
+static int cmd_leds(int fd, int leds, int fps, int seconds)
+{
+  uint8_t payload[LINK_MAX_PAYLOAD];
+  uint8_t frame[LINK_MAX_PAYLOAD + LINK_OVERHEAD];
+  std::vector<uint8_t> rgb(leds * 3u);
+
+  auto period = std::chrono::microseconds(1000000 / fps);
+  auto next = std::chrono::steady_clock::now();
+  long total = (long)fps * seconds;
+  for (long k = 0; k < total; k++) {
+    for (int i = 0; i < leds; i++) {
+      double h = (i * 1.0 / leds + k * 0.01) * 2.0 * M_PI;
+      rgb[i * 3]     = (uint8_t)(127.5 + 127.5 * std::sin(h));
+      rgb[i * 3 + 1] = (uint8_t)(127.5 + 127.5 * std::sin(h + 2.094));
+      rgb[i * 3 + 2] = (uint8_t)(127.5 + 127.5 * std::sin(h + 4.189));
+    }
+    for (int first = 0; first < leds; first += LINK_LED_MAX_LEDS) {
+      int n = std::min(LINK_LED_MAX_LEDS, leds - first);
+      payload[0] = (uint8_t)k;
+      link_put_u16(&payload[1], (uint16_t)first);
+      payload[3] = (first + n >= leds) ? LINK_LED_FLAG_END : 0;
+      memcpy(&payload[LINK_LED_HDR], &rgb[first * 3], n * 3u);
+      size_t len = link_frame_encode(LINK_TYPE_LED_FRAME, payload, (uint8_t)(LINK_LED_HDR + n * 3), frame);
+      if (!write_all(fd, frame, len)) { perror("write"); return 1; }
+    }
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+  printf("sent %ld led frames (%d leds) at %d fps\n", total, leds, fps);
+  return 0;
+}
+#endif // LINK_HOST_NO_MAIN
+
+// cut_at：确认到这个位置就不发了直接返回 3（模拟断线，回环测试用）；resumed 带回续传起点
+static int cmd_upload(int fd, const char *local, const char *remote, size_t chunk, size_t window,
+                      uint32_t cut_at = UINT32_MAX, uint32_t *resumed = nullptr)
+{
+  FILE *fp = fopen(local, "rb");
+  if (!fp) { perror(local); return 1; }
+  std::vector<uint8_t> data;
+  uint8_t tmp[4096];
+  size_t r;
+  while ((r = fread(tmp, 1, sizeof(tmp), fp)) > 0) data.insert(data.end(), tmp, tmp + r);
+  fclose(fp);
+
+  size_t name_len = strlen(remote);
+  if (name_len == 0 || name_len > LINK_UP_NAME_MAX) { fprintf(stderr, "remote name too long\n"); return 1; }
+  if (chunk == 0 || chunk > LINK_MAX_PAYLOAD - 4) chunk = LINK_MAX_PAYLOAD - 4;
+  if (window == 0) window = 1;
+
+  const uint32_t size = (uint32_t)data.size();
+  const uint32_t crc = link_crc32(data.data(), data.size());
+  LinkReader rd;
+  uint8_t status;
+  uint32_t a, b;
+
+  // 1) BEGIN：问设备续传位置，对不上就要求重来
+  uint8_t begin[9 + LINK_UP_NAME_MAX];
+  link_put_u32(begin, size);
+  link_put_u32(begin + 4, crc);
+  memcpy(begin + 9, remote, name_len);
+  uint8_t flags = 0;
+  for (int attempt = 0; ; attempt++) {
+    if (attempt == 6) { fprintf(stderr, "no answer to BEGIN\n"); return 1; }
+    begin[8] = flags;
+    send_packet(fd, LINK_TYPE_UP_BEGIN, begin, (uint8_t)(9 + name_len));
+    if (!rd.ack(fd, status, a, b, 1000)) continue;
+    if (status != LINK_UP_OK) { fprintf(stderr, "BEGIN rejected: status %u\n", status); return 1; }
+    if (a <= size && link_crc32(data.data(), a) == b) break;
+    flags = LINK_UP_FLAG_RESTART;
+  }
+  if (a > 0) printf("resuming at %u / %u\n", a, size);
+  if (resumed) *resumed = a;
+
+  // 2) 数据块：窗口内连发，按应答推进；乱序应答回退重发，超时也回退
+  const uint32_t resume = a;
+  uint32_t acked = a, next = a, rewind_at = UINT32_MAX;
+  uint32_t t0 = now_ms();
+  int timeouts = 0;
+  while (acked < size) {
+    while (next < size && next - acked < window * chunk) {
+      uint8_t pkt[LINK_MAX_PAYLOAD];
+      uint32_t n = (uint32_t)std::min<size_t>(chunk, size - next);
+      link_put_u32(pkt, next);
+      memcpy(pkt + 4, &data[next], n);
+      send_packet(fd, LINK_TYPE_UP_CHUNK, pkt, (uint8_t)(4 + n));
+      next += n;
+    }
+    if (!rd.ack(fd, status, a, b, 1000)) {
+      if (++timeouts > 10) { fprintf(stderr, "upload stalled at %u\n", acked); return 1; }
+      next = acked;
+      continue;
+    }
+    timeouts = 0;
+    if (status == LINK_UP_OK) {
+      if (a > acked) acked = a;
+      rewind_at = UINT32_MAX;
+    } else if (status == LINK_UP_BAD_OFFSET) {
+      if (a == rewind_at) continue;     // 窗口里残留的旧块，已经回退过了
+      acked = next = rewind_at = a;
+    } else {
+      fprintf(stderr, "chunk rejected at %u: status %u\n", acked, status);
+      return 1;
+    }
+    printf("\r%u / %u", acked, size);
+    fflush(stdout);
+    if (acked >= cut_at && acked < size) {
+      printf("\ncut at %u\n", acked);
+      return 3;
+    }
+  }
+  uint32_t el = now_ms() - t0;
+
+  // 3) END：设备校验 crc32 后改名
+  send_packet(fd, LINK_TYPE_UP_END, nullptr, 0);
+  if (!rd.ack(fd, status, a, b, 3000)) { fprintf(stderr, "\nno answer to END\n"); return 1; }
+  if (status != LINK_UP_OK) { fprintf(stderr, "\nEND failed: status %u\n", status); return 1; }
+
+  printf("\nuploaded %u bytes to %s, host %u B/s, device %u B/s\n",
+         size, remote, (unsigned)((uint64_t)(size - resume) * 1000 / (el ? el : 1)), b);
+  return 0;
+}
+
+#ifndef LINK_HOST_NO_MAIN
+int main(int argc, char **argv)
+{
+  if (argc < 3) {
+    fprintf(stderr, "usage: %s stream|dump|upload|leds <tty> [baud] ...\n", argv[0]);
+    return 2;
+  }
+  long baud = argc > 3 ? atol(argv[3]) : 115200;
+  int fd = open_tty(argv[2], baud);
+  if (fd < 0) return 1;
+
+  if (!strcmp(argv[1], "stream")) {
+    int hz = argc > 4 ? atoi(argv[4]) : 100;
+    int seconds = argc > 5 ? atoi(argv[5]) : 10;
+    if (hz <= 0) hz = 100;
+    return cmd_stream(fd, hz, seconds);
+  }
+  if (!strcmp(argv[1], "dump")) return cmd_dump(fd);
+  if (!strcmp(argv[1], "leds")) {
+    int leds = argc > 4 ? atoi(argv[4]) : 50;
+    int fps = argc > 5 ? atoi(argv[5]) : 30;
+    int seconds = argc > 6 ? atoi(argv[6]) : 10;
+    if (leds <= 0) leds = 50;
+    if (fps <= 0) fps = 30;
+    return cmd_leds(fd, leds, fps, seconds);
+  }
+  if (!strcmp(argv[1], "upload")) {
+    if (argc < 6) { fprintf(stderr, "usage: %s upload <tty> <baud> <local> <remote> [chunk] [window]\n", argv[0]); return 2; }
+    size_t chunk = argc > 6 ? (size_t)atol(argv[6]) : 128;
+    size_t window = argc > 7 ? (size_t)atol(argv[7]) : 4;
+    return cmd_upload(fd, argv[4], argv[5], chunk, window);
+  }
+
+  fprintf(stderr, "unknown command %s\n", argv[1]);
+  return 2;
+}
+#endif // LINK_HOST_NO_MAIN
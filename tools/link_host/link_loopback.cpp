@@ -0,0 +1,160 @@
+/*
+ * 串口上传回环测试：主机固件（HAL_NATIVE）接伪终端一端，link_host 的上传逻辑接另一端
+ *
+ * 编译（在仓库根目录）：
+ *   g++ -std=gnu++17 -O2 -DHAL_NATIVE -Isrc -o link_loopback tools/link_host/link_loopback.cpp \
+ *       src/main.cpp src/hal/hal_native.cpp src/config/config.cpp src/servo/servo_in.cpp \
+ *       src/sys/sys.cpp src/sys/cores.cpp src/sys/bus.cpp src/uart/uart_in.cpp src/stream/led_*.cpp src/stream/stream_in.cpp \
+ *       src/show/show.cpp src/upload/upload.cpp src/ws2812/ws2812*.cpp src/ASR/ASR_module.cpp
+ *
+ * 用法：link_loopback [bytes] [baud] [chunk] [window]     默认 100000 2000000 128 4
+ *
+ * 流程（全部通过返回 0）：
+ *   1. 伪随机内容上传到一半主动断开（不发 END），设备上留下 .part
+ *   2. 重新上传，必须从断点续传（BEGIN 应答的位置 > 0），END 校验通过
+ *   3. 设备文件系统里的结果和原文件逐字节比对，.part 已经不在
+ * 伪终端不按波特率限速，baud 只验证 termios 接受这个速率；打印的吞吐是协议 + 固件的上限，
+ * 真实串口速率要用 link_host upload 接板子测。
+ */
+
+#define LINK_HOST_NO_MAIN
+#include "link_host.cpp"
+
+#include "../../src/hal/hal_native.h"
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/wait.h>
+
+void setup();
+void loop();
+
+#define LOOPBACK_REMOTE  "/loopback.bin"
+
+// 子进程：固件从 HAL_UART2（伪终端从端）收包，一直转到被父进程杀掉
+static void run_firmware()
+{
+  int devnull = open("/dev/null", O_WRONLY);   // 固件日志不要混进测试输出
+  if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+  setup();
+  for (;;) {
+    hal_native_uart_poll();
+    loop();
+    usleep(100);
+  }
+}
+
+static bool read_file(const std::string &path, std::vector<uint8_t> &out)
+{
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  uint8_t buf[4096];
+  size_t n;
+  out.clear();
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+// 断开后设备可能还在回窗口里剩下的应答，收干净再开始下一次，免得被当成 BEGIN 应答
+static void drain(int fd, int quiet_ms)
+{
+  uint32_t last = now_ms();
+  while ((int32_t)(now_ms() - last) < quiet_ms) {
+    uint8_t b[256];
+    if (read(fd, b, sizeof(b)) > 0) last = now_ms();
+    else usleep(1000);
+  }
+}
+
+static int fail(const char *msg)
+{
+  fprintf(stderr, "FAIL: %s\n", msg);
+  return 1;
+}
+
+int main(int argc, char **argv)
+{
+  size_t bytes  = argc > 1 ? (size_t)atol(argv[1]) : 100000;
+  long   baud   = argc > 2 ? atol(argv[2]) : 2000000;
+  size_t chunk  = argc > 3 ? (size_t)atol(argv[3]) : 128;
+  size_t window = argc > 4 ? (size_t)atol(argv[4]) : 4;
+  if (bytes < 2) return fail("need at least 2 bytes");
+
+  speed_t speed;
+  if (!to_speed(baud, speed)) {
+    fprintf(stderr, "unsupported baud %ld on this system\n", baud);
+    return 2;
+  }
+
+  // 设备文件系统根目录 + 要上传的文件
+  char root[] = "/tmp/link_loopback.XXXXXX";
+  if (!mkdtemp(root)) { perror("mkdtemp"); return 1; }
+  const std::string local  = std::string(root) + "/host.bin";
+  const std::string remote = std::string(root) + LOOPBACK_REMOTE;
+  std::vector<uint8_t> data(bytes);
+  uint32_t x = 0x12345678;
+  for (auto &b : data) { x = x * 1664525u + 1013904223u; b = (uint8_t)(x >> 24); }
+  FILE *f = fopen(local.c_str(), "wb");
+  if (!f || fwrite(data.data(), 1, data.size(), f) != data.size()) { perror(local.c_str()); return 1; }
+  fclose(f);
+
+  // 伪终端：从端给固件，主端给上传逻辑；从端先设成原始模式（不回显、不转换换行）
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) { perror("posix_openpt"); return 1; }
+  const char *slave_path = ptsname(master);
+  int slave = open(slave_path, O_RDWR | O_NOCTTY);
+  if (slave < 0 || !tty_setup(slave, speed)) { perror(slave_path); return 1; }
+  fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+  setenv("HAL_UART2", slave_path, 1);
+  setenv("HAL_FS_ROOT", root, 1);
+  pid_t pid = fork();
+  if (pid < 0) { perror("fork"); return 1; }
+  if (pid == 0) run_firmware();
+
+  int rc = 0;
+  uint32_t resumed = 0;
+  uint32_t cut = (uint32_t)(bytes / 2);
+  printf("== upload %zu bytes, cut at %u (baud %ld, chunk %zu, window %zu)\n", bytes, cut, baud, chunk, window);
+  if (cmd_upload(master, local.c_str(), LOOPBACK_REMOTE, chunk, window, cut, &resumed) != 3) {
+    rc = fail("first upload did not stop at the cut");
+  }
+
+  if (rc == 0) {
+    drain(master, 300);
+    printf("== resume\n");
+    if (cmd_upload(master, local.c_str(), LOOPBACK_REMOTE, chunk, window, UINT32_MAX, &resumed) != 0) {
+      rc = fail("resumed upload failed");
+    } else if (resumed == 0) {
+      rc = fail("second upload started from 0 instead of resuming");
+    }
+  }
+
+  if (rc == 0) {
+    std::vector<uint8_t> got;
+    if (!read_file(remote, got)) {
+      rc = fail("uploaded file missing on the device side");
+    } else if (got != data) {
+      size_t i = 0;
+      while (i < got.size() && i < data.size() && got[i] == data[i]) i++;
+      fprintf(stderr, "first difference at byte %zu (device %zu bytes, host %zu)\n", i, got.size(), data.size());
+      rc = fail("content mismatch");
+    } else if (access((remote + ".part").c_str(), F_OK) == 0) {
+      rc = fail(".part left behind");
+    } else {
+      printf("PASS: %zu bytes identical, resumed at %u\n", got.size(), resumed);
+    }
+  }
+
+  kill(pid, SIGKILL);
+  waitpid(pid, nullptr, 0);
+  close(slave);
+  close(master);
+  unlink(local.c_str());
+  unlink(remote.c_str());
+  unlink((remote + ".part").c_str());
+  rmdir(root);
+  return rc;
+}
@@ -0,0 +1,278 @@
+/*
+ * 主机端演出模拟器：虚拟时钟快进跑完 main.cpp 里的每一条语音演出，记下时间线，和基准对比
+ *
+ * 编译（在仓库根目录）：
+ *   g++ -std=gnu++17 -O2 -DHAL_NATIVE -Isrc -o show_sim tools/show_sim/show_sim.cpp \
+ *       src/main.cpp src/hal/hal_native.cpp src/config/config.cpp src/servo/servo_in.cpp \
+ *       src/sys/sys.cpp src/sys/cores.cpp src/sys/bus.cpp src/uart/uart_in.cpp src/stream/led_*.cpp src/stream/stream_in.cpp \
+ *       src/show/show.cpp src/upload/upload.cpp src/ws2812/ws2812*.cpp src/ASR/ASR_module.cpp
+ *
+ * 用法（在仓库根目录跑，布局等文件从 data/ 读）：
+ *   show_sim                       对比 tools/show_sim/golden/ 下的全部基准，有差异返回 1
+ *   show_sim check <dir>           同上，指定基准目录
+ *   show_sim record <dir>          重新生成基准（改了编排 / 调度、确认新时间线没问题后再录）
+ *   show_sim run <id>              把一条演出的时间线打到 stdout（id 为词条编号，如 0x05）
+ *
+ * 每条演出单独 fork 一个子进程：setup() 跑完后从命令串口注入一帧 0xAA 0x55 命令，
+ * 之后每圈 loop() 前把虚拟时钟拨 1ms，直到舵机播放器和 sys 各个池都空下来并保持
+ * SIM_SETTLE_MS（最多 SIM_MAX_MS）。时间线（毫秒，以注入命令为 0）：
+ *   servo <pin> <deg>        舵机角度变化
+ *   gpio <pin> <level>       激光 / 雷达等引脚电平跳变
+ *   part <i> <mode>          灯带分区模式变化
+ *   px <crc32>               推出去的整帧像素（每 SIM_PX_SAMPLE_MS 采一次，变了才记）
+ */
+
+#include "../../src/hal/hal_native.h"
+#include "../../src/uart/uart_in.h"
+#include "../../src/servo/servo_in.h"
+#include "../../src/ws2812/ws2812.h"
+#include "../../src/sys/sys.h"
+#include "../../src/show/show.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+void setup();
+void loop();
+
+#define SIM_SETTLE_MS      500      // 空闲保持这么久算演完
+#define SIM_MAX_MS         120000   // 演不完也到此为止（时间线最后一行会标出来）
+#define SIM_PX_SAMPLE_MS   100
+
+
+// ---------- 子进程：跑一条演出 ----------
+
+static std::string g_out;
+static uint32_t    g_t0 = 0;
+
+static void emit(uint32_t ms, const char *fmt, int a, int b)
+{
+  char line[64];
+  int n = snprintf(line, sizeof(line), "%7u ", ms - g_t0);
+  n += snprintf(line + n, sizeof(line) - n, fmt, a, b);
+  g_out.append(line, n);
+  g_out.push_back('\n');
+}
+
+static void on_trace(uint32_t ms, HalNativeEvent ev, int id, int value)
+{
+  switch (ev) {
+    case HAL_NATIVE_EV_GPIO:  emit(ms, "gpio %d %d", id, value);  break;
+    case HAL_NATIVE_EV_SERVO: emit(ms, "servo %d %d", id, value); break;
+    default: break;
+  }
+}
+
+static uint32_t crc32(const uint8_t *p, size_t n)
+{
+  uint32_t c = 0xFFFFFFFFu;
+  for (size_t i = 0; i < n; i++) {
+    c ^= p[i];
+    for (int k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1)));
+  }
+  return ~c;
+}
+
+static bool sys_idle()
+{
+  SysPoolInfo pools[SYS_POOL_COUNT];
+  sys_pool_stats(pools);
+  for (int i = 0; i < SYS_POOL_COUNT; i++) {
+    if (pools[i].used) return false;
+  }
+  return true;
+}
+
+static void run_show(uint8_t id)
+{
+  hal_native_use_virtual_clock();
+  setup();
+
+  uint8_t modes[WS2812_PART_MAX];
+  for (uint8_t i = 0; i < WS2812_PART_MAX; i++) modes[i] = ws2812_part_mode(i);
+  uint32_t last_crc = 0;
+
+  // 和语音模块 / 上位机一样走命令串口：0xAA 0x55 0x00 <id> CRC8 0xFB
+  uint8_t cmd[UART_FRAME_LEN] = { UART_FRAME_HEAD0, UART_FRAME_HEAD1, 0x00, id, 0, UART_FRAME_TAIL };
+  cmd[4] = uart_crc8(&cmd[2], 2);
+  hal_native_uart_inject(UART_IN_PORT, cmd, sizeof(cmd));
+  g_t0 = hal_millis();
+  hal_native_on_trace(on_trace);
+
+  uint32_t idle_since = 0;
+  bool idle = false;
+  while (true) {
+    hal_native_advance_us(1000);
+    hal_native_uart_poll();
+    loop();
+
+    uint32_t now = hal_millis();
+    for (uint8_t i = 0; i < WS2812_PART_MAX; i++) {
+      uint8_t m = ws2812_part_mode(i);
+      if (m != modes[i]) { emit(now, "part %d %d", i, m); modes[i] = m; }
+    }
+    if ((now - g_t0) % SIM_PX_SAMPLE_MS == 0) {
+      uint16_t bytes;
+      const uint8_t *px = ws_out_native_frame(bytes);
+      uint32_t c = crc32(px, bytes);
+      if (c != last_crc) {
+        char line[32];
+        snprintf(line, sizeof(line), "%7u px %08x\n", now - g_t0, c);
+        g_out += line;
+        last_crc = c;
+      }
+    }
+
+    bool busy = Servo_IsBusy() || !sys_idle();
+    if (busy) { idle = false; continue; }
+    if (!idle) { idle = true; idle_since = now; }
+    if (now - idle_since >= SIM_SETTLE_MS) {
+      emit(idle_since, "end", 0, 0);
+      break;
+    }
+    if (now - g_t0 >= SIM_MAX_MS) {
+      emit(now, "timeout", 0, 0);
+      break;
+    }
+  }
+}
+
+// ---------- 父进程 ----------
+
+struct ShowResult {
+  std::string trace;
+  double      wall_ms;
+  bool        ok;
+};
+
+static ShowResult simulate(uint8_t id)
+{
+  ShowResult r = { std::string(), 0.0, false };
+  int fds[2];
+  if (pipe(fds) != 0) { perror("pipe"); return r; }
+
+  auto t0 = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid < 0) { perror("fork"); return r; }
+  if (pid == 0) {
+    close(fds[0]);
+    int devnull = open("/dev/null", O_WRONLY);   // 固件自己的 hal_log 不要混进时间线
+    if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+    run_show(id);
+    size_t off = 0;
+    while (off < g_out.size()) {
+      ssize_t n = write(fds[1], g_out.data() + off, g_out.size() - off);
+      if (n <= 0) _exit(1);
+      off += (size_t)n;
+    }
+    _exit(0);
+  }
+
+  close(fds[1]);
+  char buf[4096];
+  ssize_t n;
+  while ((n = read(fds[0], buf, sizeof(buf))) > 0) r.trace.append(buf, (size_t)n);
+  close(fds[0]);
+  int status = 0;
+  waitpid(pid, &status, 0);
+  r.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+  r.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  return r;
+}
+
+static std::string golden_path(const char *dir, uint8_t id)
+{
+  char name[32];
+  snprintf(name, sizeof(name), "/show_%02x.txt", id);
+  return std::string(dir) + name;
+}
+
+static bool read_file(const std::string &path, std::string &out)
+{
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  char buf[4096];
+  size_t n;
+  out.clear();
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+// 第一处不同的行（1 起），0 = 一样
+static int first_diff(const std::string &a, const std::string &b, std::string &la, std::string &lb)
+{
+  size_t pa = 0, pb = 0;
+  for (int line = 1;; line++) {
+    if (pa >= a.size() && pb >= b.size()) return 0;
+    size_t ea = a.find('\n', pa), eb = b.find('\n', pb);
+    if (ea == std::string::npos) ea = a.size();
+    if (eb == std::string::npos) eb = b.size();
+    la = pa < a.size() ? a.substr(pa, ea - pa) : "<end>";
+    lb = pb < b.size() ? b.substr(pb, eb - pb) : "<end>";
+    if (la != lb) return line;
+    pa = ea + 1;
+    pb = eb + 1;
+  }
+}
+
+static int last_ms(const std::string &trace)
+{
+  size_t p = trace.rfind('\n', trace.size() >= 2 ? trace.size() - 2 : 0);
+  return atoi(trace.c_str() + (p == std::string::npos ? 0 : p + 1));
+}
+
+static int cmd_all(const char *dir, bool record)
+{
+  int failed = 0, shows = 0;
+  double wall = 0;
+  for (int i = 1; i <= 0xFF; i++) {     // 演出表里有的编号都跑一遍（show_exists）
+    uint8_t id = (uint8_t)i;
+    if (!show_exists(id)) continue;
+    shows++;
+    ShowResult r = simulate(id);
+    wall += r.wall_ms;
+    std::string path = golden_path(dir, id);
+    printf("show 0x%02x  %6d ms show  %6.1f ms wall  ", id, last_ms(r.trace), r.wall_ms);
+    if (!r.ok) { printf("CRASHED\n"); failed++; continue; }
+
+    if (record) {
+      FILE *f = fopen(path.c_str(), "wb");
+      if (!f) { perror(path.c_str()); return 1; }
+      fwrite(r.trace.data(), 1, r.trace.size(), f);
+      fclose(f);
+      printf("recorded\n");
+      continue;
+    }
+
+    std::string golden, la, lb;
+    if (!read_file(path, golden)) { printf("no golden %s\n", path.c_str()); failed++; continue; }
+    int line = first_diff(golden, r.trace, la, lb);
+    if (line == 0) { printf("ok\n"); continue; }
+    printf("DIFF at line %d\n    golden: %s\n    now:    %s\n", line, la.c_str(), lb.c_str());
+    failed++;
+  }
+  printf("%d shows, %.0f ms wall, %d %s\n", shows, wall, failed, record ? "failed" : "mismatched");
+  return failed ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+  const char *cmd = argc > 1 ? argv[1] : "check";
+  if (!strcmp(cmd, "run") && argc > 2) {
+    ShowResult r = simulate((uint8_t)strtoul(argv[2], nullptr, 0));
+    fputs(r.trace.c_str(), stdout);
+    return r.ok ? 0 : 1;
+  }
+  const char *dir = argc > 2 ? argv[2] : "tools/show_sim/golden";
+  if (!strcmp(cmd, "check"))  return cmd_all(dir, false);
+  if (!strcmp(cmd, "record")) return cmd_all(dir, true);
+  fprintf(stderr, "usage: show_sim [check <dir> | record <dir> | run <id>]\n");
+  return 2;
+}